@@ -9,6 +9,8 @@
 #include <Assisi/Core/EventQueue.hpp>
 #include <Assisi/Core/Logger.hpp>
 #include <Assisi/Core/Reflect/ComponentRegistry.hpp>
+#include <Assisi/Debug/SceneStatsView.hpp>
+#include <Assisi/ECS/Collector.hpp>
 #include <Assisi/ECS/SceneRegistry.hpp>
 #include <Assisi/Physics/PhysicsComponents.hpp>
 #include <Assisi/Physics/PhysicsWorld.hpp>
@@ -33,6 +35,7 @@
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <optional>
 #include <string>
 
 // ---------------------------------------------------------------------------
@@ -67,6 +70,7 @@ class SandboxApp : public Assisi::App::Application
     void SetupLighting();
 
     // --- Per-frame helpers ---
+    void CreatePendingBodies();
     void HandleEntityPicking();
     void UpdateCamera(float dt);
 
@@ -95,12 +99,17 @@ class SandboxApp : public Assisi::App::Application
     Assisi::ECS::Scene                *_scene = nullptr;
     Assisi::Physics::PhysicsWorld      _physics;
 
+    /* Entities that gained a transform and a body descriptor since the last CreatePendingBodies(). */
+    std::optional<Assisi::ECS::Collector<Assisi::Runtime::TransformComponent, Assisi::Physics::RigidBodyDescriptor>>
+        _newBodies;
+
     Assisi::Render::OpenGL::MeshBuffer _cubeMesh;
     Assisi::Render::Shader             _shader;
     Assisi::Runtime::LightingSystem    _lighting;
     glm::mat4                          _projection{1.f};
 
-    Assisi::ECS::Scene  _cameraScene;
+    /* Two components that live as long as the app: an arena saves their pools a trip to the heap. */
+    Assisi::ECS::Scene  _cameraScene{Assisi::ECS::StorageMode::SparseSet, Assisi::ECS::SceneMemory::Arena};
     Assisi::ECS::Entity _cameraEntity = Assisi::ECS::NullEntity;
 
     float _yaw   = -116.6f;
@@ -182,6 +191,7 @@ void SandboxApp::OnStart()
     }
 
     _scene    = _scenes.Create("Main").value();
+    _newBodies.emplace(*_scene, Assisi::ECS::CollectorEvent::Entered);
     _cubeMesh = Assisi::Render::OpenGL::MeshBuffer(Assisi::Render::CreateUnitCubeMesh());
 
     _shader = Assisi::Render::Shader("shaders/mesh.vert", "shaders/mesh.frag");
@@ -226,6 +236,7 @@ void SandboxApp::OnResize(int width, int height)
 
 void SandboxApp::OnFixedUpdate(float dt)
 {
+    CreatePendingBodies();
     _physics.Update(dt);
     _physics.SyncTransforms(*_scene);
 }
@@ -234,6 +245,23 @@ void SandboxApp::OnFixedUpdate(float dt)
 // Per-frame helpers
 // ---------------------------------------------------------------------------
 
+void SandboxApp::CreatePendingBodies()
+{
+    _newBodies->Each(
+        [this](Assisi::ECS::Entity e)
+        {
+            if (_scene->Has<Assisi::Physics::RigidBodyComponent>(e))
+                return;
+
+            const auto &tc   = *_scene->Get<Assisi::Runtime::TransformComponent>(e);
+            const auto &desc = *_scene->Get<Assisi::Physics::RigidBodyDescriptor>(e);
+            const auto motion = desc.isStatic ? Assisi::Physics::BodyMotion::Static
+                                              : Assisi::Physics::BodyMotion::Dynamic;
+            (void)_scene->Add<Assisi::Physics::RigidBodyComponent>(
+                e, _physics.AddBox(tc.position, tc.rotation, desc.halfExtents, motion));
+        });
+}
+
 void SandboxApp::HandleEntityPicking()
 {
     auto &input = GetInput();
@@ -339,6 +367,25 @@ void SandboxApp::DrawDiagnosticsWindow()
     ImGui::Separator();
     ImGui::TextDisabled("RMB: look  |  WASD: move  |  Space/Ctrl: up/down");
     ImGui::TextDisabled("Scroll: FOV  |  LMB: select  |  Esc: quit");
+
+    if (ImGui::CollapsingHeader("ECS"))
+    {
+        if (ImGui::Button("Compact"))
+        {
+            /* Drain the collector first: Compact() invalidates the handles it holds. */
+            CreatePendingBodies();
+            const Assisi::ECS::CompactReport report = _scene->Compact();
+            _selectedEntity = report.Remap(_selectedEntity);
+            Assisi::Core::Log::Info("Compacted scene: {} -> {} entity slots, {} -> {} bytes", report.slotsBefore,
+                                    report.slotsAfter, report.bytesBefore, report.bytesAfter);
+        }
+        ImGui::SameLine();
+
+        const Assisi::ECS::SceneStats stats = _scene->Stats();
+        if (ImGui::Button("Dump JSON"))
+            Assisi::Core::Log::Info("{}", Assisi::Debug::SceneStatsView::ToJson(stats));
+        Assisi::Debug::SceneStatsView::Draw(stats);
+    }
     ImGui::End();
 }
 
@@ -610,14 +657,8 @@ void SandboxApp::LoadLevel(const std::string &name)
     for (auto [e, mrc] : _scene->Query<Assisi::Runtime::MeshRendererComponent>())
         mrc.mesh = &_cubeMesh;
 
-    for (auto [e, tc, desc] : _scene->Query<Assisi::Runtime::TransformComponent,
-                                             Assisi::Physics::RigidBodyDescriptor>())
-    {
-        const auto motion = desc.isStatic ? Assisi::Physics::BodyMotion::Static
-                                          : Assisi::Physics::BodyMotion::Dynamic;
-        (void)_scene->Add<Assisi::Physics::RigidBodyComponent>(
-            e, _physics.AddBox(tc.position, tc.rotation, desc.halfExtents, motion));
-    }
+    /* The load added every body the level has; only those entities need one. */
+    CreatePendingBodies();
 }
 
 // ---------------------------------------------------------------------------
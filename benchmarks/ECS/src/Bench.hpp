@@ -0,0 +1,125 @@
+#pragma once
+
+/// @file Bench.hpp
+/// @brief Minimal timing harness for the ECS microbenchmarks.
+///
+/// Each case runs `repetitions` times.  A repetition calls setup() untimed,
+/// then times one call of run(), which performs `operations` operations; the
+/// case reports nanoseconds per operation as the median and minimum over the
+/// repetitions.  Cases may also Check() what they computed; a failed check
+/// is reported and makes the run exit non-zero.  Results are kept as JSON
+/// objects so the suite can dump them in one document for comparing builds
+/// (see tools/bench/compare.py).
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace Assisi::Bench
+{
+
+/// Written by KeepAlive(); volatile, so every store is observable.
+template <typename T> inline volatile T Sink{};
+
+/// @brief Keeps a computed value alive so the optimizer cannot drop the loop that produced it.
+template <typename T> void KeepAlive(const T &value)
+{
+    Sink<T> = value;
+}
+
+struct Options
+{
+    std::size_t repetitions = 5;
+    std::size_t maxEntities = 1'000'000; ///< Cases with more entities are skipped.
+    std::string filter;                   ///< Only cases whose name contains this run.
+};
+
+class Suite
+{
+  public:
+    explicit Suite(Options options) : _options(std::move(options)) {}
+
+    const Options &Settings() const { return _options; }
+
+    /// @brief Returns true if a case of this name and entity count should run.
+    bool Enabled(std::string_view name, std::size_t entities) const
+    {
+        return entities <= _options.maxEntities &&
+               (_options.filter.empty() || name.find(_options.filter) != std::string_view::npos);
+    }
+
+    /// @brief Times `run` after an untimed `setup` per repetition and records the result under `name`.
+    ///
+    /// `params` describes the case (entity count, component count, ...) and is
+    /// copied into the result next to the timings.
+    template <typename Setup, typename Run>
+    void Measure(std::string_view name, nlohmann::json params, std::size_t operations, Setup &&setup, Run &&run)
+    {
+        std::vector<double> samples;
+        samples.reserve(_options.repetitions);
+        for (std::size_t rep = 0; rep < _options.repetitions; ++rep)
+        {
+            setup();
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        std::ranges::sort(samples);
+
+        const double ops    = static_cast<double>(std::max<std::size_t>(operations, 1));
+        const double median = samples[samples.size() / 2] / ops;
+        const double best   = samples.front() / ops;
+
+        std::fprintf(stderr, "%-28s %-60s %10.2f ns/op (min %.2f)\n", std::string(name).c_str(), params.dump().c_str(),
+                     median, best);
+
+        _results.push_back({{"name", name},
+                            {"params", std::move(params)},
+                            {"operations", operations},
+                            {"repetitions", samples.size()},
+                            {"nsPerOpMedian", median},
+                            {"nsPerOpMin", best}});
+    }
+
+    /// @brief Records a failed correctness check of a case; the run then exits non-zero.
+    void Check(bool ok, std::string_view what)
+    {
+        if (ok)
+            return;
+        std::fprintf(stderr, "FAILED: %s\n", std::string(what).c_str());
+        ++_failures;
+    }
+
+    std::size_t Failures() const { return _failures; }
+
+    /// @brief All results so far, as the JSON document the suite writes out.
+    nlohmann::json Report() const
+    {
+#ifdef NDEBUG
+        constexpr bool optimized = true;
+#else
+        constexpr bool optimized = false;
+#endif
+        return {{"version", 1},
+                {"suite", "ECS"},
+                {"optimized", optimized},
+                {"repetitions", _options.repetitions},
+                {"failures", _failures},
+                {"results", _results}};
+    }
+
+  private:
+    Options _options;
+    nlohmann::json _results = nlohmann::json::array();
+    std::size_t _failures = 0;
+};
+
+} // namespace Assisi::Bench
@@ -0,0 +1,699 @@
+/// @file main.cpp
+/// @brief Assisi-Bench-ECS — microbenchmarks for entity allocation, pools, queries, chunked iteration and scene
+///        teardown.
+///
+/// Usage:
+///   Assisi-Bench-ECS [--out results.json] [--filter Query] [--max-entities 100000] [--repetitions 5]
+///
+/// Progress goes to stderr as a table; the JSON report goes to --out, or to
+/// stdout without it.  Build in Release for numbers worth comparing.  Cases
+/// that also check their results (Scene/Compact, Scene/Reserve) make the run
+/// exit with 1 when a check fails.
+
+#include "Bench.hpp"
+
+#include <Assisi/Core/JobSystem.hpp>
+#include <Assisi/Core/Reflect/ComponentRegistry.hpp>
+#include <Assisi/ECS/Registry.hpp>
+#include <Assisi/ECS/Scene.hpp>
+#include <Assisi/ECS/SparseSet.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using Assisi::Bench::KeepAlive;
+using Assisi::Bench::Suite;
+using namespace Assisi::ECS;
+
+/// Distinct 16-byte component types, so a query over N of them touches N pools.
+template <std::size_t I> struct Component
+{
+    float value[4] = {1.f, 0.f, 0.f, 0.f};
+};
+
+struct Position
+{
+    float x = 0.f, y = 0.f, z = 0.f;
+};
+
+struct Velocity
+{
+    float x = 1.f, y = 2.f, z = 3.f;
+};
+
+/// A reflected EntityRef (registered by RegisterLink()), so Compact() has a field to rewrite.
+struct Link
+{
+    Entity target = NullEntity;
+};
+
+constexpr std::array<std::size_t, 3> EntityCounts = {10'000, 100'000, 1'000'000};
+constexpr std::array<double, 3> Overlaps = {1.0, 0.5, 0.1};
+
+const char *ModeName(StorageMode mode)
+{
+    return mode == StorageMode::SparseSet ? "sparse" : "archetype";
+}
+
+/// `entities` in a fixed random order, for access patterns the prefetcher cannot follow.
+std::vector<Entity> ShuffledHandles(std::span<const Entity> entities)
+{
+    std::vector<Entity> shuffled(entities.begin(), entities.end());
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(1234));
+    return shuffled;
+}
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+
+void BenchRegistry(Suite &suite)
+{
+    for (const std::size_t count : EntityCounts)
+    {
+        const nlohmann::json params = {{"entities", count}};
+        std::unique_ptr<Registry> registry;
+        std::vector<Entity> entities(count);
+
+        if (suite.Enabled("Registry/Create", count))
+        {
+            suite.Measure(
+                "Registry/Create", params, count, [&] { registry = std::make_unique<Registry>(); },
+                [&]
+                {
+                    for (Entity &entity : entities)
+                        entity = registry->Create();
+                });
+        }
+
+        if (suite.Enabled("Registry/CreateMany", count))
+        {
+            suite.Measure(
+                "Registry/CreateMany", params, count, [&] { registry = std::make_unique<Registry>(); },
+                [&] { registry->CreateMany(entities); });
+        }
+
+        std::vector<Entity> order;
+        const auto fill = [&]
+        {
+            registry = std::make_unique<Registry>();
+            registry->CreateMany(entities);
+            if (order.empty())
+                order = ShuffledHandles(entities);
+        };
+
+        if (suite.Enabled("Registry/Destroy", count))
+        {
+            suite.Measure("Registry/Destroy", params, count, fill,
+                          [&]
+                          {
+                              for (const Entity entity : order)
+                                  registry->Destroy(entity);
+                          });
+        }
+
+        if (suite.Enabled("Registry/DestroyMany", count))
+            suite.Measure("Registry/DestroyMany", params, count, fill, [&] { registry->DestroyMany(order); });
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SparseSet
+// ---------------------------------------------------------------------------
+
+void BenchSparseSet(Suite &suite)
+{
+    using Pool = SparseSet<Component<0>>;
+
+    for (const std::size_t count : EntityCounts)
+    {
+        const nlohmann::json params = {{"entities", count}};
+        std::vector<Entity> entities(count);
+        for (std::size_t i = 0; i < count; ++i)
+            entities[i] = {static_cast<uint32_t>(i), 0};
+        const std::vector<Entity> order = ShuffledHandles(entities);
+
+        std::unique_ptr<Pool> pool;
+        const auto fill = [&]
+        {
+            pool = std::make_unique<Pool>();
+            for (const Entity entity : entities)
+                (void)pool->Add(entity);
+        };
+
+        if (suite.Enabled("SparseSet/Add", count))
+        {
+            suite.Measure(
+                "SparseSet/Add", params, count, [&] { pool = std::make_unique<Pool>(); },
+                [&]
+                {
+                    for (const Entity entity : entities)
+                        (void)pool->Add(entity);
+                });
+        }
+
+        if (suite.Enabled("SparseSet/Remove", count))
+        {
+            suite.Measure("SparseSet/Remove", params, count, fill,
+                          [&]
+                          {
+                              for (const Entity entity : order)
+                                  pool->Remove(entity);
+                          });
+        }
+
+        if (suite.Enabled("SparseSet/Get", count))
+        {
+            fill();
+            suite.Measure(
+                "SparseSet/Get", params, count, [] {},
+                [&]
+                {
+                    float sum = 0.f;
+                    for (const Entity entity : order)
+                        sum += pool->Get(entity)->value[0];
+                    KeepAlive(sum);
+                });
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Scene
+// ---------------------------------------------------------------------------
+
+/// @brief Fills `scene` with `count` entities: all have Component<0>, each other one is on `overlap` of them.
+template <std::size_t... Is>
+void Populate(Scene &scene, std::size_t count, double overlap, std::index_sequence<Is...>)
+{
+    std::vector<Entity> entities(count);
+    scene.CreateMany(entities);
+
+    std::mt19937 rng(42);
+    std::bernoulli_distribution pick(overlap);
+    const auto add = [&]<std::size_t I>(std::integral_constant<std::size_t, I>)
+    {
+        std::vector<Entity> chosen;
+        for (const Entity entity : entities)
+        {
+            if (I == 0 || pick(rng))
+                chosen.push_back(entity);
+        }
+        const std::vector<Component<I>> values(chosen.size());
+        (void)scene.AddMany<Component<I>>(chosen, values);
+    };
+    (add(std::integral_constant<std::size_t, Is>{}), ...);
+}
+
+template <std::size_t... Is> std::size_t QueryPass(Scene &scene, float &sum)
+{
+    std::size_t matches = 0;
+    for (auto &&row : scene.Query<Component<Is>...>())
+    {
+        sum += std::get<1>(row).value[0];
+        ++matches;
+    }
+    return matches;
+}
+
+template <std::size_t... Is>
+void BenchQuery(Suite &suite, Scene &scene, nlohmann::json params, std::size_t count, std::index_sequence<Is...>)
+{
+    float sum = 0.f;
+    params["components"] = sizeof...(Is);
+    params["matches"]    = QueryPass<Is...>(scene, sum);
+    suite.Measure(
+        "Scene/Query", std::move(params), count, [] {},
+        [&]
+        {
+            float pass = 0.f;
+            QueryPass<Is...>(scene, pass);
+            KeepAlive(pass);
+        });
+}
+
+void BenchScene(Suite &suite)
+{
+    constexpr std::size_t MaxComponents = 5;
+
+    for (const StorageMode mode : {StorageMode::SparseSet, StorageMode::Archetype})
+    {
+        for (const std::size_t count : EntityCounts)
+        {
+            if (suite.Enabled("Scene/Get", count) && mode == StorageMode::SparseSet)
+            {
+                Scene scene(mode);
+                Populate(scene, count, 1.0, std::make_index_sequence<1>{});
+                std::vector<Entity> entities(count);
+                for (std::size_t i = 0; i < count; ++i)
+                    entities[i] = {static_cast<uint32_t>(i), 0};
+                const std::vector<Entity> order = ShuffledHandles(entities);
+
+                suite.Measure(
+                    "Scene/Get", {{"entities", count}, {"mode", ModeName(mode)}}, count, [] {},
+                    [&]
+                    {
+                        float sum = 0.f;
+                        for (const Entity entity : order)
+                            sum += scene.Get<Component<0>>(entity)->value[0];
+                        KeepAlive(sum);
+                    });
+            }
+
+            if (suite.Enabled("Scene/Query", count))
+            {
+                for (const double overlap : Overlaps)
+                {
+                    Scene scene(mode);
+                    Populate(scene, count, overlap, std::make_index_sequence<MaxComponents>{});
+
+                    const nlohmann::json params = {{"entities", count}, {"overlap", overlap}, {"mode", ModeName(mode)}};
+                    BenchQuery(suite, scene, params, count, std::make_index_sequence<1>{});
+                    BenchQuery(suite, scene, params, count, std::make_index_sequence<2>{});
+                    BenchQuery(suite, scene, params, count, std::make_index_sequence<3>{});
+                    BenchQuery(suite, scene, params, count, std::make_index_sequence<4>{});
+                    BenchQuery(suite, scene, params, count, std::make_index_sequence<5>{});
+                }
+            }
+
+            if (suite.Enabled("Scene/Clear", count))
+            {
+                Scene scene(mode);
+                suite.Measure(
+                    "Scene/Clear", {{"entities", count}, {"components", 3}, {"mode", ModeName(mode)}}, count,
+                    [&] { Populate(scene, count, 1.0, std::make_index_sequence<3>{}); }, [&] { scene.Clear(); });
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Position integration: per-row query iteration against EachChunk() spans
+// ---------------------------------------------------------------------------
+
+/// @brief `count` entities with Position and Velocity; `scattered` adds the Velocities in shuffled order.
+///
+/// Shuffling puts the two sparse-set pools out of step, so EachChunk() runs
+/// degrade to single entities: the worst case for it.  Archetype scenes keep
+/// both columns aligned in every chunk regardless of insertion order.
+void PopulateMovers(Scene &scene, std::size_t count, bool scattered)
+{
+    std::vector<Entity> entities(count);
+    scene.CreateMany(entities);
+    const std::vector<Position> positions(count);
+    const std::vector<Velocity> velocities(count);
+    (void)scene.AddMany<Position>(entities, positions);
+    (void)scene.AddMany<Velocity>(scattered ? ShuffledHandles(entities) : entities, velocities);
+}
+
+void BenchIntegrate(Suite &suite)
+{
+    constexpr float Dt = 1.f / 60.f;
+
+    for (const StorageMode mode : {StorageMode::SparseSet, StorageMode::Archetype})
+    {
+        for (const std::size_t count : EntityCounts)
+        {
+            if (!suite.Enabled("Scene/Integrate", count))
+                continue;
+
+            for (const bool scattered : {false, true})
+            {
+                if (scattered && mode == StorageMode::Archetype)
+                    continue;
+
+                Scene scene(mode);
+                PopulateMovers(scene, count, scattered);
+                const nlohmann::json params = {
+                    {"entities", count}, {"mode", ModeName(mode)}, {"layout", scattered ? "scattered" : "aligned"}};
+
+                nlohmann::json rows = params;
+                rows["iteration"] = "rows";
+                suite.Measure(
+                    "Scene/Integrate", std::move(rows), count, [] {},
+                    [&]
+                    {
+                        for (auto [entity, pos, vel] : scene.Query<Position, Velocity>())
+                        {
+                            pos.x += vel.x * Dt;
+                            pos.y += vel.y * Dt;
+                            pos.z += vel.z * Dt;
+                        }
+                        KeepAlive(scene.Get<Position>(Entity{0, 0})->x);
+                    });
+
+                nlohmann::json chunks = params;
+                chunks["iteration"] = "chunks";
+                suite.Measure(
+                    "Scene/Integrate", std::move(chunks), count, [] {},
+                    [&]
+                    {
+                        scene.Query<Position, Velocity>().EachChunk(
+                            [](std::span<const Entity>, std::span<Position> pos, std::span<const Velocity> vel)
+                            {
+                                for (std::size_t i = 0; i < pos.size(); ++i)
+                                {
+                                    pos[i].x += vel[i].x * Dt;
+                                    pos[i].y += vel[i].y * Dt;
+                                    pos[i].z += vel[i].z * Dt;
+                                }
+                            });
+                        KeepAlive(scene.Get<Position>(Entity{0, 0})->x);
+                    });
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Parallel query scaling
+// ---------------------------------------------------------------------------
+
+/// 0, 1, 2, 4, ... workers, ending with hardware_concurrency() - 1 (the calling thread always helps).
+std::vector<std::size_t> WorkerCounts()
+{
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts = {0};
+    for (std::size_t workers = 1; workers < hardware - 1; workers *= 2)
+        counts.push_back(workers);
+    if (hardware > 1)
+        counts.push_back(hardware - 1);
+    return counts;
+}
+
+void BenchParallel(Suite &suite)
+{
+    constexpr float Dt = 1.f / 60.f;
+
+    const std::vector<std::size_t> workerCounts = WorkerCounts();
+    for (const StorageMode mode : {StorageMode::SparseSet, StorageMode::Archetype})
+    {
+        for (const std::size_t count : EntityCounts)
+        {
+            if (!suite.Enabled("Query/ParallelEach", count))
+                continue;
+
+            Scene scene(mode);
+            PopulateMovers(scene, count, false);
+            for (const std::size_t workers : workerCounts)
+            {
+                Assisi::Core::JobSystem jobs(workers);
+                suite.Measure(
+                    "Query/ParallelEach", {{"entities", count}, {"mode", ModeName(mode)}, {"workers", workers}}, count,
+                    [] {},
+                    [&]
+                    {
+                        scene.Query<Position, Velocity>().ParallelEach(
+                            jobs,
+                            [](Entity, Position &pos, const Velocity &vel)
+                            {
+                                pos.x += vel.x * Dt;
+                                pos.y += vel.y * Dt;
+                                pos.z += vel.z * Dt;
+                            });
+                        KeepAlive(scene.Get<Position>(Entity{0, 0})->x);
+                    });
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Compaction after spawn/despawn churn
+// ---------------------------------------------------------------------------
+
+void RegisterLink()
+{
+    namespace Reflect = Assisi::Core::Reflect;
+    auto &registry = Reflect::ComponentRegistry::Instance();
+    if (registry.FindByType(typeid(Link)))
+        return;
+
+    /* Only the field table matters here; Link is never serialized. */
+    registry.Register({"Link",
+                       typeid(Link),
+                       {{"target", Reflect::FieldType::EntityRef, offsetof(Link, target), false}},
+                       {},
+                       {},
+                       {},
+                       {},
+                       {}});
+}
+
+/// A scene after waves of spawns and despawns, with what Compact() must preserve.
+struct ChurnedScene
+{
+    std::unique_ptr<Scene> scene;
+    std::vector<Entity> survivors; ///< Live handles before Compact().
+    std::vector<Entity> targets;   ///< Link::target of each survivor before Compact(); may be dead.
+};
+
+/// @brief Spawns `count` entities in waves, each linking to a random earlier one, and despawns most of them.
+///
+/// Every entity's Position holds its own original handle, so its components
+/// can be told apart after it has been renumbered.
+ChurnedScene Churn(StorageMode mode, std::size_t count)
+{
+    constexpr std::size_t Waves = 8;
+
+    ChurnedScene churned{std::make_unique<Scene>(mode), {}, {}};
+    Scene &scene = *churned.scene;
+    std::vector<Entity> &live = churned.survivors;
+    std::mt19937 rng(99);
+
+    for (std::size_t wave = 0; wave < Waves; ++wave)
+    {
+        std::vector<Entity> spawned(count / Waves);
+        scene.CreateMany(spawned);
+        for (const Entity entity : spawned)
+        {
+            const Position original{static_cast<float>(entity.index), static_cast<float>(entity.generation), 0.f};
+            (void)scene.Add<Position>(entity, original);
+            (void)scene.Add<Link>(entity, {live.empty() ? entity : live[rng() % live.size()]});
+        }
+        live.insert(live.end(), spawned.begin(), spawned.end());
+
+        /* Keep a quarter, so later waves reuse most slots and leave holes behind. */
+        std::shuffle(live.begin(), live.end(), rng);
+        const std::size_t kept = live.size() / 4;
+        scene.DestroyMany(std::span<const Entity>(live).subspan(kept));
+        live.resize(kept);
+    }
+
+    for (const Entity entity : live)
+        churned.targets.push_back(scene.Get<Link>(entity)->target);
+    return churned;
+}
+
+/// @brief Checks that `report` kept every survivor's components and links.
+void VerifyCompact(Suite &suite, const ChurnedScene &churned, const CompactReport &report)
+{
+    const Scene &scene = *churned.scene;
+    std::size_t lost = 0;
+    std::size_t brokenLinks = 0;
+    for (std::size_t i = 0; i < churned.survivors.size(); ++i)
+    {
+        const Entity original = churned.survivors[i];
+        const Entity moved = report.Remap(original);
+        const Position *position = scene.IsAlive(moved) ? scene.Get<Position>(moved) : nullptr;
+        if (!position || position->x != static_cast<float>(original.index) ||
+            position->y != static_cast<float>(original.generation))
+        {
+            ++lost;
+            continue;
+        }
+
+        /* Links to entities that died during the churn must come out null. */
+        const Entity expected = report.Remap(churned.targets[i]);
+        const Link *link = scene.Get<Link>(moved);
+        if (!link || link->target != expected || (expected != NullEntity && !scene.IsAlive(expected)))
+            ++brokenLinks;
+    }
+
+    suite.Check(lost == 0, "Scene/Compact: a surviving entity lost its components");
+    suite.Check(brokenLinks == 0, "Scene/Compact: an EntityRef field points at the wrong entity");
+    suite.Check(scene.AliveCount() == churned.survivors.size(), "Scene/Compact: alive count changed");
+    suite.Check(report.bytesAfter < report.bytesBefore, "Scene/Compact: memory did not shrink");
+}
+
+void BenchCompact(Suite &suite)
+{
+    RegisterLink();
+
+    for (const StorageMode mode : {StorageMode::SparseSet, StorageMode::Archetype})
+    {
+        for (const std::size_t count : EntityCounts)
+        {
+            if (!suite.Enabled("Scene/Compact", count))
+                continue;
+
+            ChurnedScene churned;
+            CompactReport report;
+            suite.Measure(
+                "Scene/Compact", {{"entities", count}, {"mode", ModeName(mode)}}, count,
+                [&] { churned = Churn(mode, count); }, [&] { report = churned.scene->Compact(); });
+            VerifyCompact(suite, churned, report);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Concurrent Reserve() on a partly freed registry
+// ---------------------------------------------------------------------------
+
+/// @brief Checks that the flush made every reserved handle alive and that no two threads got the same slot.
+void VerifyReserve(Suite &suite, const Scene &scene, std::span<const std::vector<Entity>> reserved, std::size_t kept)
+{
+    std::vector<uint32_t> indices;
+    std::size_t dead = 0;
+    for (const std::vector<Entity> &handles : reserved)
+    {
+        for (const Entity entity : handles)
+        {
+            indices.push_back(entity.index);
+            if (!scene.IsAlive(entity))
+                ++dead;
+        }
+    }
+    std::ranges::sort(indices);
+
+    suite.Check(std::ranges::adjacent_find(indices) == indices.end(), "Scene/Reserve: an entity was handed out twice");
+    suite.Check(dead == 0, "Scene/Reserve: a reserved entity is not alive after FlushReserved()");
+    suite.Check(scene.AliveCount() == kept + indices.size(), "Scene/Reserve: alive count does not match");
+}
+
+void BenchReserve(Suite &suite)
+{
+    /* At least four threads, so the free list is contended even on small machines. */
+    const std::size_t threadCount = std::max<std::size_t>(4, std::thread::hardware_concurrency());
+
+    for (const std::size_t count : EntityCounts)
+    {
+        if (!suite.Enabled("Scene/Reserve", count))
+            continue;
+
+        const std::size_t perThread = count / threadCount;
+        const std::size_t kept      = count - count / 2;
+        std::unique_ptr<Scene> scene;
+        std::vector<std::vector<Entity>> reserved(threadCount);
+
+        /* Half the slots are freed, so the reserves first race over the free list, then over fresh indices. */
+        const auto freeHalf = [&]
+        {
+            scene = std::make_unique<Scene>();
+            std::vector<Entity> entities(count);
+            scene->CreateMany(entities);
+            const std::vector<Entity> order = ShuffledHandles(entities);
+            scene->DestroyMany(std::span<const Entity>(order).first(count / 2));
+            for (std::vector<Entity> &handles : reserved)
+            {
+                handles.clear();
+                handles.reserve(perThread);
+            }
+        };
+
+        /* Thread start-up is timed too; it is small next to the reserves at these counts. */
+        suite.Measure("Scene/Reserve", {{"entities", count}, {"threads", threadCount}}, perThread * threadCount,
+                      freeHalf,
+                      [&]
+                      {
+                          std::vector<std::thread> threads;
+                          threads.reserve(threadCount);
+                          for (std::vector<Entity> &handles : reserved)
+                          {
+                              threads.emplace_back(
+                                  [&scene, &handles, perThread]
+                                  {
+                                      for (std::size_t i = 0; i < perThread; ++i)
+                                          handles.push_back(scene->Reserve());
+                                  });
+                          }
+                          for (std::thread &thread : threads)
+                              thread.join();
+                          scene->FlushReserved();
+                      });
+        VerifyReserve(suite, *scene, reserved, kept);
+    }
+}
+
+bool ParseCount(std::string_view text, std::size_t &out)
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Assisi::Bench::Options options;
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        const std::string_view value = i + 1 < argc ? std::string_view(argv[i + 1]) : std::string_view{};
+        bool ok = !value.empty();
+
+        if (arg == "--out")
+            outPath = value;
+        else if (arg == "--filter")
+            options.filter = value;
+        else if (arg == "--max-entities")
+            ok = ok && ParseCount(value, options.maxEntities);
+        else if (arg == "--repetitions")
+            ok = ok && ParseCount(value, options.repetitions) && options.repetitions > 0;
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            std::fprintf(stderr, "usage: %s [--out file] [--filter text] [--max-entities n] [--repetitions n]\n",
+                         argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+
+    Suite suite(options);
+    BenchRegistry(suite);
+    BenchSparseSet(suite);
+    BenchScene(suite);
+    BenchIntegrate(suite);
+    BenchParallel(suite);
+    BenchCompact(suite);
+    BenchReserve(suite);
+
+    const int status = suite.Failures() == 0 ? 0 : 1;
+    const std::string report = suite.Report().dump(2);
+    if (outPath.empty())
+    {
+        std::cout << report << '\n';
+        return status;
+    }
+
+    std::ofstream file(outPath);
+    file << report << '\n';
+    if (!file)
+    {
+        std::fprintf(stderr, "cannot write '%s'\n", outPath.c_str());
+        return 1;
+    }
+    return status;
+}
@@ -26,7 +26,28 @@
 ///
 /// Systems run in dependency order within each phase.
 /// Systems with no ordering relationship run in registration order.
+///
+/// Each system remembers the scene tick it last ran at and receives it as
+/// `ctx.lastRunTick`, so it can query only what changed since then:
+/// @code
+/// for (auto [e, t] : ctx.scene.Query<TransformComponent, ECS::Changed<TransformComponent>>(ctx.lastRunTick))
+///     ...
+/// @endcode
+/// The scene tick advances after every system, so a system never sees its own changes.
+///
+/// Structural changes made while iterating (including from ParallelEach
+/// callbacks) go through `ctx.Commands()`, which records into the calling
+/// thread's ECS::CommandBuffer.  Every buffer is played back once the phase's
+/// last system has returned.
+///
+/// Per-scene singletons are read with `ctx.Resource<T>()`, which indexes the
+/// scene's resource slots directly:
+/// @code
+/// if (auto *settings = ctx.Resource<LightingSettings>())
+///     ...
+/// @endcode
 
+#include <Assisi/ECS/CommandBuffer.hpp>
 #include <Assisi/ECS/Scene.hpp>
 #include <Assisi/Math/GLM.hpp>
 #include <Assisi/Window/ActionMap.hpp>
@@ -45,10 +66,21 @@ namespace Assisi::App
 /// @brief Passed to game logic systems (PreUpdate, FixedUpdate, Update, PostUpdate).
 struct SystemContext
 {
-    ECS::Scene            &scene;
-    float                  dt;
-    Window::InputContext  &input;
-    Window::ActionMap     &actions;
+    ECS::Scene                &scene;
+    float                      dt;
+    Window::InputContext      &input;
+    Window::ActionMap         &actions;
+    ECS::Tick                  lastRunTick = 0;   ///< Scene tick when this system last ran; set by SystemRegistry.
+    ECS::ThreadCommandBuffers *commands = nullptr; ///< Played back after the phase; set by SystemRegistry.
+
+    /// @brief The calling thread's command buffer.
+    ///
+    /// Call it from the system itself or from Core::JobSystem::Instance()
+    /// workers only (see ECS::ThreadCommandBuffers::Local()).
+    ECS::CommandBuffer &Commands() const { return commands->Local(); }
+
+    /// @brief The scene's T resource, or nullptr if none is set (see ECS::Scene::SetResource()).
+    template <typename T> T *Resource() const { return scene.Resource<T>(); }
 };
 
 /// @brief Passed to render systems (Render phase only).
@@ -58,6 +90,10 @@ struct RenderContext
     float        dt;
     glm::mat4    view;
     glm::mat4    projection;
+    ECS::Tick    lastRunTick = 0; ///< Scene tick when this system last ran; set by SystemRegistry.
+
+    /// @brief The scene's T resource, or nullptr if none is set (see ECS::Scene::SetResource()).
+    template <typename T> T *Resource() const { return scene.Resource<T>(); }
 };
 
 /// @brief Execution phase that determines when a system runs and which context it receives.
@@ -130,6 +166,7 @@ class SystemRegistry
         std::function<void(SystemContext &)> fn;
         std::vector<std::string>           after;
         std::vector<std::string>           before;
+        ECS::Tick                          lastRun = 0;
     };
 
     struct RenderEntry
@@ -138,6 +175,7 @@ class SystemRegistry
         std::function<void(RenderContext &)> fn;
         std::vector<std::string>           after;
         std::vector<std::string>           before;
+        ECS::Tick                          lastRun = 0;
     };
 
     /// Number of game-logic phases (everything except Render).
@@ -157,6 +195,8 @@ class SystemRegistry
     std::array<std::vector<std::size_t>, kGamePhaseCount> _sorted;
     std::array<bool, kGamePhaseCount>                     _dirty{};
 
+    ECS::ThreadCommandBuffers _commands; ///< Shared by every game-logic phase; empty between Run() calls.
+
     std::vector<RenderEntry>  _renderEntries;
     std::vector<std::size_t>  _renderSorted;
     bool                      _renderDirty = false;
@@ -158,7 +158,7 @@ SystemRegistry::SystemHandle SystemRegistry::Register(SystemPhase
 {
     const std::size_t pi = Index(phase);
     const std::size_t ei = _entries[pi].size();
-    _entries[pi].push_back({std::string(name), std::move(fn), {}, {}});
+    _entries[pi].push_back({std::string(name), std::move(fn), {}, {}, 0});
     _dirty[pi] = true;
     return SystemHandle(this, /*isRender=*/false, pi, ei);
 }
@@ -168,7 +168,7 @@ SystemRegistry::SystemHandle SystemRegistry::Register(SystemPhase
                                                        std::function<void(RenderContext &)> fn)
 {
     const std::size_t ei = _renderEntries.size();
-    _renderEntries.push_back({std::string(name), std::move(fn), {}, {}});
+    _renderEntries.push_back({std::string(name), std::move(fn), {}, {}, 0});
     _renderDirty = true;
     return SystemHandle(this, /*isRender=*/true, /*phaseIndex=*/0, ei);
 }
@@ -183,8 +183,20 @@ void SystemRegistry::Run(SystemPhase phase, SystemContext ctx)
     if (_dirty[pi])
         SortPhase(pi);
 
+    ctx.commands = &_commands;
     for (std::size_t i : _sorted[pi])
-        _entries[pi][i].fn(ctx);
+    {
+        GameEntry &entry = _entries[pi][i];
+        ctx.lastRunTick  = entry.lastRun;
+        entry.fn(ctx);
+
+        /* Changes made from here on get a newer tick than this system has seen. */
+        entry.lastRun = ctx.scene.CurrentTick();
+        ctx.scene.AdvanceTick();
+    }
+
+    /* Sync point: no system of this phase is iterating any more. */
+    _commands.Playback(ctx.scene);
 }
 
 void SystemRegistry::Run(SystemPhase, RenderContext ctx)
@@ -193,7 +205,14 @@ void SystemRegistry::Run(SystemPhase, RenderContext ctx)
         SortRender();
 
     for (std::size_t i : _renderSorted)
-        _renderEntries[i].fn(ctx);
+    {
+        RenderEntry &entry = _renderEntries[i];
+        ctx.lastRunTick    = entry.lastRun;
+        entry.fn(ctx);
+
+        entry.lastRun = ctx.scene.CurrentTick();
+        ctx.scene.AdvanceTick();
+    }
 }
 
 // ---------------------------------------------------------------------------
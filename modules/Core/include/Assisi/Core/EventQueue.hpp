@@ -52,10 +52,10 @@
 
 #include <memory>
 #include <span>
-#include <typeindex>
-#include <unordered_map>
 #include <vector>
 
+#include <Assisi/Core/TypeId.hpp>
+
 namespace Assisi::Core
 {
 
@@ -82,17 +82,20 @@ class EventQueue
     template <typename E>
     std::span<const E> Read() const
     {
-        auto it = _queues.find(typeid(E));
-        if (it == _queues.end())
+        const TypeId id = TypeIdFamily<EventQueue>::Of<E>();
+        if (id >= _queues.size() || !_queues[id])
             return {};
-        return static_cast<const TypedQueue<E> &>(*it->second).events;
+        return static_cast<const TypedQueue<E> &>(*_queues[id]).events;
     }
 
     /// @brief Clear all event queues.  Called by Application once per frame.
     void Flush()
     {
-        for (auto &[type, queue] : _queues)
-            queue->Clear();
+        for (auto &queue : _queues)
+        {
+            if (queue)
+                queue->Clear();
+        }
     }
 
   private:
@@ -112,15 +115,15 @@ class EventQueue
     template <typename E>
     TypedQueue<E> &GetOrCreate()
     {
-        auto it = _queues.find(typeid(E));
-        if (it != _queues.end())
-            return static_cast<TypedQueue<E> &>(*it->second);
-
-        auto result = _queues.emplace(typeid(E), std::make_unique<TypedQueue<E>>());
-        return static_cast<TypedQueue<E> &>(*result.first->second);
+        const TypeId id = TypeIdFamily<EventQueue>::Of<E>();
+        if (id >= _queues.size())
+            _queues.resize(id + 1);
+        if (!_queues[id])
+            _queues[id] = std::make_unique<TypedQueue<E>>();
+        return static_cast<TypedQueue<E> &>(*_queues[id]);
     }
 
-    std::unordered_map<std::type_index, std::unique_ptr<IQueue>> _queues;
+    std::vector<std::unique_ptr<IQueue>> _queues; ///< Indexed by TypeIdFamily<EventQueue> id; null until first Push.
 };
 
 } // namespace Assisi::Core
\ No newline at end of file
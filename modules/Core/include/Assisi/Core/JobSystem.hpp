@@ -0,0 +1,105 @@
+#pragma once
+
+/// @file Core/JobSystem.hpp
+/// @brief Work-stealing thread pool for data-parallel loops.
+///
+/// Every worker owns a task deque.  A worker pops its own newest task first
+/// (good cache reuse for nested work) and, when empty, steals the oldest task
+/// from another worker.  The thread that calls ParallelFor() splits the range
+/// into tasks, spreads them over the deques and then helps execute them until
+/// the whole range is done, so ParallelFor() is blocking and may be nested.
+///
+/// @par Example
+/// @code
+/// Core::JobSystem::Instance().ParallelFor(items.size(), 256,
+///     [&](std::size_t begin, std::size_t end)
+///     {
+///         for (std::size_t i = begin; i < end; ++i)
+///             items[i] *= 2.f;
+///     });
+/// @endcode
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Assisi::Core
+{
+
+class JobSystem
+{
+  public:
+    /// @brief Process-wide pool sized to hardware_concurrency() - 1 workers.
+    static JobSystem &Instance();
+
+    /// @brief Starts `workerCount` worker threads.  Zero makes every ParallelFor() run inline.
+    explicit JobSystem(std::size_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &)            = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /// @brief Number of background worker threads (the calling thread is not counted).
+    [[nodiscard]] std::size_t WorkerCount() const { return _workers.size(); }
+
+    /// @brief Index of the calling thread: 0 for any non-worker thread, 1..WorkerCount() for workers.
+    ///
+    /// Useful for indexing per-thread scratch data sized WorkerCount() + 1.
+    [[nodiscard]] static std::size_t ThreadIndex();
+
+    /// @brief Calls fn(begin, end) over [0, count) in sub-ranges of at most `grain` elements.
+    ///
+    /// Blocks until every sub-range has been processed.  Sub-ranges run
+    /// concurrently on the workers and the calling thread; fn must be safe to
+    /// invoke from several threads at once.
+    template <typename Fn> void ParallelFor(std::size_t count, std::size_t grain, Fn &&fn)
+    {
+        using FnType = std::remove_reference_t<Fn>;
+        Dispatch(
+            count, grain,
+            [](void *context, std::size_t begin, std::size_t end) { (*static_cast<FnType *>(context))(begin, end); },
+            const_cast<void *>(static_cast<const void *>(&fn)));
+    }
+
+  private:
+    using RangeFn = void (*)(void *context, std::size_t begin, std::size_t end);
+
+    struct Task
+    {
+        RangeFn                   fn;
+        void                     *context;
+        std::size_t               begin;
+        std::size_t               end;
+        std::atomic<std::size_t> *pending; ///< Decremented once the task has run.
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    void Dispatch(std::size_t count, std::size_t grain, RangeFn fn, void *context);
+    void WorkerLoop(std::size_t index);
+
+    /// @brief Pops from queue `index` (newest first), otherwise steals the oldest task elsewhere.
+    bool TryTake(std::size_t index, Task &out);
+
+    static void Run(const Task &task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues; ///< [0] = external callers, [i] = worker i.
+    std::vector<std::thread>                  _workers;
+
+    std::mutex              _sleepMutex;
+    std::condition_variable _wake;
+    std::atomic<std::size_t> _queued{0}; ///< Tasks sitting in any queue.
+    bool                     _running = true;
+};
+
+} // namespace Assisi::Core
@@ -8,6 +8,8 @@
 ///
 /// Both accept a comma-separated list of flags and key=value pairs:
 ///   ACOMP()
+///   ACOMP(soa)                   -- component has an ECS::SoaLayout; serialized via SoaRef::Load()
+///   ACOMP(resource)              -- per-scene singleton (ECS::Scene::SetResource), not a component
 ///   AFIELD()
 ///   AFIELD(transient)            -- excluded from serialization
 ///   AFIELD(min=0.0, max=100.0)   -- editor hints (future use)
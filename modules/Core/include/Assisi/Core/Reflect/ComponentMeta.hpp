@@ -6,6 +6,10 @@
 /// addToScene uses a fully type-erased signature so Core does not need to
 /// depend on ECS.  Generated code in higher-level modules (Runtime, etc.)
 /// provides a lambda that casts scene_ptr back to the concrete Scene type.
+///
+/// Types annotated ACOMP(resource) are scene resources rather than
+/// components: they fill findResource/setResource and leave addToScene and
+/// iterateEntities empty.
 
 #include <cstdint>
 #include <functional>
@@ -48,6 +52,15 @@ struct ComponentMeta
     ///   cb        — called once per entity: (entity_index, entity_gen, component_ptr).
     std::function<void(void *scene_ptr, std::function<void(uint32_t, uint32_t, const void *)>)>
         iterateEntities;
+
+    /// @brief Return the scene's instance of this resource type, or nullptr if it has none.
+    ///   scene_ptr — pointer to an ECS::Scene, cast to void*.
+    std::function<const void *(void *scene_ptr)> findResource;
+
+    /// @brief Deserialize this resource type from JSON and set it on a scene.
+    ///   scene_ptr — pointer to an ECS::Scene, cast to void*.
+    ///   j         — JSON object for this resource.
+    std::function<void(void *scene_ptr, const nlohmann::json &j)> setResource;
 };
 
 } // namespace Assisi::Core::Reflect
\ No newline at end of file
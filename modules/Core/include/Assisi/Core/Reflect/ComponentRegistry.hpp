@@ -8,6 +8,7 @@
 
 #include <span>
 #include <string_view>
+#include <typeindex>
 #include <vector>
 
 #include <Assisi/Core/Reflect/ComponentMeta.hpp>
@@ -26,6 +27,9 @@ class ComponentRegistry
     /// @brief Find a component by its string name, or nullptr if not found.
     const ComponentMeta *Find(std::string_view name) const;
 
+    /// @brief Find a component by its C++ type, or nullptr if it is not reflected.
+    const ComponentMeta *FindByType(std::type_index type) const;
+
     /// @brief Iterate all registered component types.
     std::span<const ComponentMeta> All() const;
 
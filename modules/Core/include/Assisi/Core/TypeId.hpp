@@ -0,0 +1,48 @@
+#pragma once
+
+/// @file Core/TypeId.hpp
+/// @brief Dense per-process type ids for array-indexed type lookup.
+///
+/// TypeIdFamily<Family>::Of<T>() hands out 0, 1, 2, ... to types in the order
+/// they are first asked for, separately for each Family tag.  Ids are stable
+/// for the lifetime of the process but not across runs, so never serialize them.
+/// Containers keyed by type can then use a plain vector instead of hashing
+/// std::type_index on every lookup.
+///
+/// @par Example
+/// @code
+/// struct EventFamily;
+/// const TypeId id = TypeIdFamily<EventFamily>::Of<CollisionEvent>();
+/// if (id < _queues.size() && _queues[id]) ...
+/// @endcode
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace Assisi::Core
+{
+
+using TypeId = uint32_t;
+
+template <typename Family> class TypeIdFamily
+{
+  public:
+    /// @brief Returns T's id within Family.  cv/ref qualifiers are ignored.
+    template <typename T> static TypeId Of() { return Id<std::remove_cvref_t<T>>(); }
+
+    /// @brief Number of ids handed out so far.
+    static TypeId Count() { return _next.load(std::memory_order_relaxed); }
+
+  private:
+    template <typename T> static TypeId Id()
+    {
+        /* Function-local static: assigned once, thread-safe, on first use. */
+        static const TypeId id = _next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    static inline std::atomic<TypeId> _next{0};
+};
+
+} // namespace Assisi::Core
@@ -22,6 +22,14 @@ const ComponentMeta *ComponentRegistry::Find(std::string_view name) const
     return nullptr;
 }
 
+const ComponentMeta *ComponentRegistry::FindByType(std::type_index type) const
+{
+    for (const auto &m : _metas)
+        if (m.typeIndex == type)
+            return &m;
+    return nullptr;
+}
+
 std::span<const ComponentMeta> ComponentRegistry::All() const
 {
     return _metas;
@@ -0,0 +1,159 @@
+/// @file JobSystem.cpp
+
+#include <Assisi/Core/JobSystem.hpp>
+
+#include <algorithm>
+
+namespace Assisi::Core
+{
+
+namespace
+{
+
+thread_local std::size_t t_threadIndex = 0;
+
+} // namespace
+
+JobSystem &JobSystem::Instance()
+{
+    static JobSystem instance(std::max(1u, std::thread::hardware_concurrency()) - 1u);
+    return instance;
+}
+
+JobSystem::JobSystem(std::size_t workerCount)
+{
+    _queues.reserve(workerCount + 1);
+    for (std::size_t i = 0; i <= workerCount; ++i)
+        _queues.push_back(std::make_unique<WorkerQueue>());
+
+    _workers.reserve(workerCount);
+    for (std::size_t i = 1; i <= workerCount; ++i)
+        _workers.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(_sleepMutex);
+        _running = false;
+    }
+    _wake.notify_all();
+
+    for (std::thread &worker : _workers)
+        worker.join();
+}
+
+std::size_t JobSystem::ThreadIndex()
+{
+    return t_threadIndex;
+}
+
+void JobSystem::Dispatch(std::size_t count, std::size_t grain, RangeFn fn, void *context)
+{
+    if (count == 0)
+        return;
+
+    grain = std::max<std::size_t>(grain, 1);
+
+    /* Nothing to share the work with: skip the queues entirely. */
+    if (_workers.empty() || count <= grain)
+    {
+        fn(context, 0, count);
+        return;
+    }
+
+    const std::size_t taskCount = (count + grain - 1) / grain;
+    std::atomic<std::size_t> pending{taskCount};
+
+    /* Count the tasks before publishing them so a fast thief can never drive
+       the counter below zero. */
+    _queued.fetch_add(taskCount, std::memory_order_release);
+
+    /* Deal the tasks round-robin, starting with the caller's own queue so it
+       has local work and the workers start stealing immediately. */
+    const std::size_t self = ThreadIndex();
+    for (std::size_t t = 0; t < taskCount; ++t)
+    {
+        const std::size_t begin = t * grain;
+        const std::size_t end   = std::min(count, begin + grain);
+
+        WorkerQueue &queue = *_queues[(self + t) % _queues.size()];
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back({fn, context, begin, end, &pending});
+        }
+    }
+
+    {
+        /* Empty critical section: a worker between its predicate check and
+           wait() cannot miss this notification. */
+        std::lock_guard lock(_sleepMutex);
+    }
+    _wake.notify_all();
+
+    /* Help out until every task of this call has run.  The caller may end up
+       running tasks from other ParallelFor calls too, which is fine. */
+    Task task{};
+    while (pending.load(std::memory_order_acquire) != 0)
+    {
+        if (TryTake(self, task))
+            Run(task);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::WorkerLoop(std::size_t index)
+{
+    t_threadIndex = index;
+
+    Task task{};
+    while (true)
+    {
+        if (TryTake(index, task))
+        {
+            Run(task);
+            continue;
+        }
+
+        std::unique_lock lock(_sleepMutex);
+        _wake.wait(lock, [this] { return !_running || _queued.load(std::memory_order_acquire) != 0; });
+        if (!_running)
+            return;
+    }
+}
+
+bool JobSystem::TryTake(std::size_t index, Task &out)
+{
+    const std::size_t queueCount = _queues.size();
+    for (std::size_t offset = 0; offset < queueCount; ++offset)
+    {
+        WorkerQueue &queue = *_queues[(index + offset) % queueCount];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        /* Own queue: LIFO.  Victim queue: FIFO, taking the largest-grained, oldest work. */
+        if (offset == 0)
+        {
+            out = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            out = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        _queued.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Run(const Task &task)
+{
+    task.fn(task.context, task.begin, task.end);
+    task.pending->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace Assisi::Core
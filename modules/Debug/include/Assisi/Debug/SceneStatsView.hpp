@@ -0,0 +1,33 @@
+#pragma once
+
+/// @file SceneStatsView.hpp
+/// @brief Live ImGui table and JSON dump of an ECS scene's memory and occupancy.
+///
+/// Usage:
+///   // inside any ImGui window, every frame:
+///   SceneStatsView::Draw(scene.Stats());
+///   // on demand, e.g. from a button or a periodic timer:
+///   Log::Info("{}", SceneStatsView::ToJson(scene.Stats()));
+///
+/// Pools are listed largest first; a pool at 90% or more of its budget (see
+/// ECS::Scene::SetPoolBudget()) is drawn in red.  Components are named after
+/// their reflected name when they have one, their type_info name otherwise.
+
+#include <string>
+
+#include <Assisi/ECS/Scene.hpp>
+
+namespace Assisi::Debug
+{
+
+class SceneStatsView
+{
+  public:
+    /// @brief Draws the entity table summary and one row per pool (or archetype) into the current window.
+    static void Draw(const ECS::SceneStats &stats);
+
+    /// @brief Returns `stats` as a JSON document, indented by `indent` spaces (compact if negative).
+    static std::string ToJson(const ECS::SceneStats &stats, int indent = 2);
+};
+
+} // namespace Assisi::Debug
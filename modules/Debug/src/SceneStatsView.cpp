@@ -0,0 +1,174 @@
+/* Copyright (c) 2025 Francisco Vivas Puerto (aka "DaFrancc"). */
+
+#include <Assisi/Debug/SceneStatsView.hpp>
+
+#include <Assisi/Core/Reflect/ComponentRegistry.hpp>
+
+#include <imgui.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <typeindex>
+#include <vector>
+
+namespace Assisi::Debug
+{
+
+namespace
+{
+
+/// Reflected name of the component, or its (possibly mangled) type_info name.
+std::string ComponentName(const ECS::PoolStats &pool)
+{
+    const auto *meta = Core::Reflect::ComponentRegistry::Instance().FindByType(*pool.type);
+    return meta ? meta->name : pool.type->name();
+}
+
+std::size_t PoolBytes(const ECS::PoolStats &pool) { return pool.denseBytes + pool.sparseBytes; }
+
+void BytesCell(std::size_t bytes)
+{
+    if (bytes >= 1024 * 1024)
+        ImGui::Text("%.2f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    else if (bytes >= 1024)
+        ImGui::Text("%.1f KB", static_cast<double>(bytes) / 1024.0);
+    else
+        ImGui::Text("%zu B", bytes);
+}
+
+void DrawPools(const std::vector<ECS::PoolStats> &pools)
+{
+    std::vector<std::size_t> order(pools.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::sort(order, [&](std::size_t a, std::size_t b) { return PoolBytes(pools[a]) > PoolBytes(pools[b]); });
+
+    constexpr ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("##pools", 7, flags))
+        return;
+
+    ImGui::TableSetupColumn("Component");
+    ImGui::TableSetupColumn("Size / Capacity");
+    ImGui::TableSetupColumn("Dense");
+    ImGui::TableSetupColumn("Sparse");
+    ImGui::TableSetupColumn("Sparse use");
+    ImGui::TableSetupColumn("Total");
+    ImGui::TableSetupColumn("Budget");
+    ImGui::TableHeadersRow();
+
+    std::size_t total = 0;
+    for (const std::size_t index : order)
+    {
+        const ECS::PoolStats &pool = pools[index];
+        const std::size_t bytes = PoolBytes(pool);
+        total += bytes;
+
+        const bool nearBudget = pool.budget != 0 && bytes * 10 >= pool.budget * 9;
+        if (nearBudget)
+            ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 96, 96, 255));
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(ComponentName(pool).c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu / %zu", pool.size, pool.capacity);
+        ImGui::TableNextColumn();
+        BytesCell(pool.denseBytes);
+        ImGui::TableNextColumn();
+        BytesCell(pool.sparseBytes);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f%%", pool.SparseOccupancy() * 100.0);
+        ImGui::TableNextColumn();
+        BytesCell(bytes);
+        ImGui::TableNextColumn();
+        if (pool.budget != 0)
+            BytesCell(pool.budget);
+        else
+            ImGui::TextDisabled("-");
+
+        if (nearBudget)
+            ImGui::PopStyleColor();
+    }
+
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+    ImGui::TextDisabled("Total");
+    ImGui::TableSetColumnIndex(5);
+    BytesCell(total);
+    ImGui::EndTable();
+}
+
+void DrawArchetypes(const std::vector<ECS::ArchetypeStats> &archetypes)
+{
+    constexpr ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("##archetypes", 4, flags))
+        return;
+
+    ImGui::TableSetupColumn("Archetype");
+    ImGui::TableSetupColumn("Components");
+    ImGui::TableSetupColumn("Size / Capacity");
+    ImGui::TableSetupColumn("Chunks");
+    ImGui::TableHeadersRow();
+
+    for (std::size_t i = 0; i < archetypes.size(); ++i)
+    {
+        const ECS::ArchetypeStats &archetype = archetypes[i];
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("#%zu", i);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", archetype.components);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu / %zu", archetype.size, archetype.capacity);
+        ImGui::TableNextColumn();
+        BytesCell(archetype.bytes);
+    }
+    ImGui::EndTable();
+}
+
+} // namespace
+
+void SceneStatsView::Draw(const ECS::SceneStats &stats)
+{
+    ImGui::Text("Entities: %zu alive, %zu slots (%zu free)", stats.alive, stats.slots, stats.freeSlots);
+
+    if (!stats.pools.empty())
+        DrawPools(stats.pools);
+    if (!stats.archetypes.empty())
+        DrawArchetypes(stats.archetypes);
+}
+
+std::string SceneStatsView::ToJson(const ECS::SceneStats &stats, int indent)
+{
+    nlohmann::json json;
+    json["entities"] = {{"alive", stats.alive}, {"slots", stats.slots}, {"freeSlots", stats.freeSlots}};
+
+    nlohmann::json pools = nlohmann::json::array();
+    for (const ECS::PoolStats &pool : stats.pools)
+    {
+        pools.push_back({{"component", ComponentName(pool)},
+                         {"size", pool.size},
+                         {"capacity", pool.capacity},
+                         {"denseBytes", pool.denseBytes},
+                         {"sparseBytes", pool.sparseBytes},
+                         {"sparseSlots", pool.sparseSlots},
+                         {"sparseOccupancy", pool.SparseOccupancy()},
+                         {"budget", pool.budget}});
+    }
+    json["pools"] = std::move(pools);
+
+    nlohmann::json archetypes = nlohmann::json::array();
+    for (const ECS::ArchetypeStats &archetype : stats.archetypes)
+    {
+        archetypes.push_back({{"components", archetype.components},
+                              {"size", archetype.size},
+                              {"capacity", archetype.capacity},
+                              {"bytes", archetype.bytes}});
+    }
+    json["archetypes"] = std::move(archetypes);
+
+    return json.dump(indent);
+}
+
+} // namespace Assisi::Debug
@@ -0,0 +1,289 @@
+#pragma once
+
+/// @file Archetype.hpp
+/// @brief Archetype (chunked SoA) component storage, the opt-in alternative to per-type SparseSets.
+///
+/// Entities sharing the same component signature are grouped into one Archetype.
+/// An archetype stores its rows in fixed-size chunks; inside a chunk every
+/// component type has its own packed column:
+///
+///   chunk bytes:  [Entity × N][T0 × N][T1 × N] ...   (each column aligned for its type)
+///
+/// so a query walks the matching chunks linearly instead of hopping through a
+/// sparse array per component per entity.
+///
+/// Adding or removing a component moves the entity's row into the archetype for
+/// its new signature.  Rows stay packed: removing a row relocates the archetype's
+/// last row into the hole, so every chunk except the last one is always full.
+///
+/// Selected per scene with `Scene(StorageMode::Archetype)`.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Assisi/ECS/Entity.hpp>
+#include <Assisi/ECS/SparseSet.hpp>
+
+namespace Assisi::ECS
+{
+
+/// @brief Type-erased description of a component type used to lay out archetype columns.
+struct ComponentInfo
+{
+    std::type_index type;
+    std::size_t     size;
+    std::size_t     align;
+    void (*relocate)(void *dst, void *src); ///< Move-constructs *dst from *src, then destroys *src.
+    void (*destroy)(void *ptr);
+    void (*copy)(void *dst, const void *src); ///< Copy-constructs *dst from *src; nullptr if T is not copyable.
+    bool trivial;                             ///< Trivially copyable: columns are copied with memcpy.
+
+    template <typename T> static const ComponentInfo &Of()
+    {
+        static const ComponentInfo info{
+            typeid(T),
+            sizeof(T),
+            alignof(T),
+            [](void *dst, void *src)
+            {
+                T *from = static_cast<T *>(src);
+                ::new (dst) T(std::move(*from));
+                from->~T();
+            },
+            [](void *ptr) { static_cast<T *>(ptr)->~T(); },
+            CopyOf<T>(),
+            std::is_trivially_copyable_v<T>,
+        };
+        return info;
+    }
+
+  private:
+    template <typename T> static constexpr void (*CopyOf())(void *, const void *)
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+            return [](void *dst, const void *src) { ::new (dst) T(*static_cast<const T *>(src)); };
+        else
+            return nullptr;
+    }
+};
+
+/// @brief All entities that have exactly one particular set of component types.
+struct Archetype
+{
+    /// @brief Target size of one chunk.  Archetypes whose single row exceeds this get one row per chunk.
+    static constexpr std::size_t ChunkBytes = 16 * 1024;
+
+    /// @brief Alignment of every chunk allocation (one cache line).
+    static constexpr std::size_t ChunkAlign = 64;
+
+    explicit Archetype(std::vector<const ComponentInfo *> components);
+
+    Archetype(const Archetype &)            = delete;
+    Archetype &operator=(const Archetype &) = delete;
+
+    /// @brief Returns the column index of the given type, or -1 if the archetype does not contain it.
+    [[nodiscard]] int ColumnIndex(std::type_index type) const;
+
+    /// @brief Returns true if the archetype's signature contains the given type.
+    [[nodiscard]] bool Has(std::type_index type) const { return ColumnIndex(type) >= 0; }
+
+    /// @brief Component descriptors, sorted by type.  This is the archetype's signature.
+    [[nodiscard]] const std::vector<const ComponentInfo *> &Components() const { return _components; }
+
+    /// @brief Total number of rows (entities) across all chunks.
+    [[nodiscard]] uint32_t Size() const { return _size; }
+
+    /// @brief Maximum rows per chunk.
+    [[nodiscard]] uint32_t Capacity() const { return _capacity; }
+
+    /// @brief Rows the allocated chunks hold, used or not.
+    [[nodiscard]] std::size_t RowCapacity() const { return _chunks.size() * _capacity; }
+
+    /// @brief Bytes held by the allocated chunks.
+    [[nodiscard]] std::size_t MemoryBytes() const { return _chunks.size() * _chunkBytes; }
+
+    /// @brief Number of chunks holding at least one row.
+    [[nodiscard]] std::size_t ChunkCount() const { return (_size + _capacity - 1) / _capacity; }
+
+    /// @brief Number of rows stored in the given (in-use) chunk.
+    [[nodiscard]] uint32_t ChunkSize(std::size_t chunk) const
+    {
+        const std::size_t first = chunk * _capacity;
+        return static_cast<uint32_t>(std::min<std::size_t>(_capacity, _size - first));
+    }
+
+    /// @brief Packed entity column of a chunk.
+    [[nodiscard]] Entity *Entities(std::size_t chunk) const { return reinterpret_cast<Entity *>(_chunks[chunk].get()); }
+
+    /// @brief Base pointer of a component column within a chunk.
+    [[nodiscard]] void *Column(std::size_t chunk, std::size_t column) const
+    {
+        return _chunks[chunk].get() + _offsets[column];
+    }
+
+    /// @brief Address of one component value, addressed by archetype-wide row.
+    [[nodiscard]] void *At(std::size_t column, uint32_t row) const
+    {
+        return static_cast<std::byte *>(Column(row / _capacity, column)) +
+               static_cast<std::size_t>(row % _capacity) * _components[column]->size;
+    }
+
+    /// @brief Entity stored at the given archetype-wide row.
+    [[nodiscard]] Entity EntityAt(uint32_t row) const { return Entities(row / _capacity)[row % _capacity]; }
+
+  private:
+    friend class ArchetypeStorage;
+
+    struct ChunkDeleter
+    {
+        void operator()(std::byte *ptr) const { ::operator delete(ptr, std::align_val_t{ChunkAlign}); }
+    };
+
+    /// @brief Appends a row for the entity.  Component columns of the new row are left uninitialised.
+    uint32_t AppendRow(Entity entity);
+
+    /// @brief Relocates the last row into `row` and shrinks by one.
+    ///
+    /// The components at `row` must already have been destroyed or moved out.
+    /// @return The entity that now occupies `row`, or NullEntity if `row` was the last row.
+    Entity EraseRow(uint32_t row);
+
+    /// @brief Destroys every component of every row and resets the size to zero.  Chunks are kept.
+    void DestroyRows();
+
+    /// @brief Copies every row of `other`, which must have the same signature, into this empty archetype.
+    void CopyRows(const Archetype &other);
+
+    /// @brief Allocates one more chunk.
+    void AddChunk();
+
+    std::vector<const ComponentInfo *> _components;
+    std::vector<std::size_t>           _offsets;   ///< Byte offset of each column within a chunk.
+    std::size_t                        _chunkBytes = ChunkBytes;
+    uint32_t                           _capacity   = 1;
+    uint32_t                           _size       = 0;
+
+    std::vector<std::unique_ptr<std::byte, ChunkDeleter>> _chunks; ///< Allocated chunks; may exceed ChunkCount().
+
+    /// Cached signature transitions, keyed by the component type added or removed.
+    std::unordered_map<std::type_index, Archetype *> _addEdges;
+    std::unordered_map<std::type_index, Archetype *> _removeEdges;
+};
+
+/// @brief Owns all archetypes of a scene and maps entity indices to their rows.
+class ArchetypeStorage
+{
+  public:
+    ArchetypeStorage() = default;
+    ~ArchetypeStorage();
+
+    ArchetypeStorage(const ArchetypeStorage &)            = delete;
+    ArchetypeStorage &operator=(const ArchetypeStorage &) = delete;
+
+    /// @brief Adds a component to the entity, moving it to the archetype for its new signature.
+    ///
+    /// @return Pointer to the new component on success, or
+    ///         SparseSetError::AlreadyExists if the entity already has one.
+    template <typename T> [[nodiscard]] std::expected<T *, SparseSetError> Add(Entity entity, T component = {})
+    {
+        void *slot = Insert(entity, ComponentInfo::Of<T>());
+        if (slot == nullptr)
+            return std::unexpected(SparseSetError::AlreadyExists);
+        return ::new (slot) T(std::move(component));
+    }
+
+    /// @brief Removes the component of type T from the entity.  Does nothing if not present.
+    template <typename T> void Remove(Entity entity) { Erase(entity, ComponentInfo::Of<T>()); }
+
+    /// @brief Returns a pointer to the entity's component of type T, or nullptr if not present.
+    template <typename T> T *Get(Entity entity) const { return static_cast<T *>(Find(entity, typeid(T))); }
+
+    /// @brief Returns true if the entity has a component of type T.
+    template <typename T> bool Has(Entity entity) const { return Find(entity, typeid(T)) != nullptr; }
+
+    /// @brief Destroys every component of the entity and forgets its row.
+    void RemoveEntity(Entity entity);
+
+    /// @brief Destroys all components of all entities.  Archetypes and chunks are kept for reuse.
+    void Clear();
+
+    /// @brief Renames every stored entity e to remap[e.index] and frees the chunks no row uses.
+    ///
+    /// `count` is one past the highest new index.  Used by Scene::Compact().
+    void Reindex(std::span<const Entity> remap, std::size_t count);
+
+    /// @brief Replaces this storage's contents with a copy of `other`'s, reusing archetypes and chunks.
+    ///
+    /// Columns of trivially copyable types are copied with one memcpy per chunk.
+    /// @return false, without changing anything, if a stored component type is not copy-constructible.
+    bool CopyFrom(const ArchetypeStorage &other);
+
+    /// @brief Calls fn(archetype, chunkIndex) for every non-empty chunk whose archetype satisfies match(archetype).
+    template <typename Match, typename Fn> void ForEachMatchingChunk(Match &&match, Fn &&fn) const
+    {
+        for (const auto &archetype : _archetypes)
+        {
+            if (archetype->Size() == 0 || !match(*archetype))
+                continue;
+
+            for (std::size_t chunk = 0; chunk < archetype->ChunkCount(); ++chunk)
+                fn(*archetype, chunk);
+        }
+    }
+
+    /// @brief All archetypes created so far, including currently empty ones.
+    [[nodiscard]] const std::vector<std::unique_ptr<Archetype>> &Archetypes() const { return _archetypes; }
+
+    /// @brief Bytes held by every archetype's chunks plus the entity location table.
+    [[nodiscard]] std::size_t MemoryBytes() const
+    {
+        std::size_t bytes = _locations.capacity() * sizeof(Location);
+        for (const auto &archetype : _archetypes)
+            bytes += archetype->MemoryBytes();
+        return bytes;
+    }
+
+  private:
+    struct Location
+    {
+        Archetype *archetype = nullptr; ///< nullptr = entity has no components.
+        uint32_t   row       = 0;
+    };
+
+    /// @brief Moves the entity into the archetype with `info` added.
+    /// @return The uninitialised slot for the new component, or nullptr if it already exists.
+    void *Insert(Entity entity, const ComponentInfo &info);
+
+    /// @brief Moves the entity into the archetype with `info` removed, destroying that component.
+    void Erase(Entity entity, const ComponentInfo &info);
+
+    /// @brief Address of the entity's component of the given type, or nullptr.
+    void *Find(Entity entity, std::type_index type) const;
+
+    /// @brief Moves the entity's row from its current archetype to `target`.
+    ///
+    /// Components shared by both signatures are relocated; components missing
+    /// from `target` are destroyed.  Returns the entity's new row.
+    uint32_t MoveEntity(Entity entity, Location &location, Archetype &target);
+
+    /// @brief Returns the archetype reached from `from` by adding or removing `info`.
+    Archetype &Transition(Archetype *from, const ComponentInfo &info, bool add);
+
+    /// @brief Finds the archetype with exactly this (sorted) signature, creating it on first use.
+    Archetype &FindOrCreate(std::vector<const ComponentInfo *> components);
+
+    std::vector<Location>                   _locations; ///< Indexed by entity index.
+    std::vector<std::unique_ptr<Archetype>> _archetypes;
+};
+
+} // namespace Assisi::ECS
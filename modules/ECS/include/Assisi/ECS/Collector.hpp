@@ -0,0 +1,188 @@
+#pragma once
+
+/// @file Collector.hpp
+/// @brief Accumulates the entities whose match against a signature changed, for incremental systems.
+///
+/// A system that creates something per matching entity (a physics body, a GPU
+/// light slot, a render proxy) would otherwise rescan every pool each frame to
+/// find the few entities that are new.  A Collector listens to the scene's
+/// component signals (see Scene::OnAdded()) and records those entities as the
+/// changes happen, so the system's work is proportional to what changed:
+///
+/// @code
+///   // Member of a system, created once:
+///   ECS::Collector<Transform, RigidBodyDescriptor> _newBodies{scene, ECS::CollectorEvent::Entered};
+///   ECS::Collector<RigidBodyComponent> _lostBodies{scene, ECS::CollectorEvent::Exited};
+///
+///   // Each run:
+///   _newBodies.Each([&](ECS::Entity e) { CreateBody(e); });
+///   _lostBodies.Each([&](ECS::Entity e) { DestroyBodyOf(e); });
+/// @endcode
+///
+/// An entity is recorded at most once until the next Each() or Clear(), no
+/// matter how often it changed.  Exited listens to Removed, which fires
+/// before the component goes away, but the collector only keeps the handle:
+/// by the time Each() runs the component, and possibly the entity, is gone,
+/// so keep whatever the cleanup needs outside the component (or use
+/// Scene::OnRemoved() directly).
+///
+/// Scene::Clear() and CloneInto() report no events.  Entered and Updated
+/// collectors check each entity still matches before handing it out, so
+/// they stay correct across those; an Exited collector just misses them.
+///
+/// A Collector connects on construction and disconnects on destruction, so it
+/// must not outlive its scene.  It cannot be copied or moved.
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <Assisi/ECS/Entity.hpp>
+#include <Assisi/ECS/Scene.hpp>
+
+namespace Assisi::ECS
+{
+
+/// @brief Which changes a Collector records.
+enum class CollectorEvent : uint8_t
+{
+    Entered, ///< The entity gained the last missing component of the signature.
+    Exited,  ///< The entity matched the signature and lost one of its components, or was destroyed.
+    Updated, ///< The entity matches and one of the signature's components was patched or marked changed.
+};
+
+/// @brief Entities that entered, left or updated the signature Ts... since the last Each() or Clear().
+///
+/// Ts are plain component types (no Optional/Exclude/Changed terms).
+template <typename... Ts> class Collector
+{
+    static_assert(sizeof...(Ts) >= 1, "A collector needs at least one component type");
+
+  public:
+    Collector(Scene &scene, CollectorEvent event) : _scene(&scene), _event(event) { (Connect<Ts>(), ...); }
+
+    Collector(const Collector &)            = delete;
+    Collector &operator=(const Collector &) = delete;
+
+    ~Collector()
+    {
+        for (const SignalConnection &connection : _connections)
+            _scene->Disconnect(connection);
+    }
+
+    CollectorEvent Event() const { return _event; }
+
+    /// @brief The recorded entities, in recording order until the first erase.  May include stale handles.
+    std::span<const Entity> Entities() const { return _entities; }
+
+    std::size_t Size() const { return _entities.size(); }
+    bool Empty() const { return _entities.empty(); }
+
+    /// @brief Forgets every recorded entity.
+    void Clear()
+    {
+        for (Entity entity : _entities)
+            _positions[entity.index] = Invalid;
+        _entities.clear();
+    }
+
+    /// @brief Calls fn(entity) for every recorded entity, then forgets them.
+    ///
+    /// Entered and Updated skip entities that no longer match.  fn may change
+    /// the scene freely: anything it causes is recorded for the next call.
+    template <typename Fn> void Each(Fn &&fn)
+    {
+        /* Swap the set out first so fn's own changes cannot grow it under the loop. */
+        std::swap(_entities, _draining);
+        for (Entity entity : _draining)
+            _positions[entity.index] = Invalid;
+
+        for (Entity entity : _draining)
+        {
+            if (_event == CollectorEvent::Exited || _scene->Matches<Ts...>(entity))
+                fn(entity);
+        }
+        _draining.clear();
+    }
+
+  private:
+    static constexpr uint32_t Invalid = UINT32_MAX;
+
+    template <typename T> void Connect()
+    {
+        switch (_event)
+        {
+        case CollectorEvent::Entered:
+            _connections.push_back(_scene->OnAdded<T>([this](Scene &scene, Entity entity)
+                                                      {
+                                                          if (scene.Matches<Ts...>(entity))
+                                                              Insert(entity);
+                                                      }));
+            _connections.push_back(_scene->OnRemoved<T>([this](Scene &, Entity entity) { Erase(entity); }));
+            break;
+
+        case CollectorEvent::Exited:
+            /* Removed fires before the component goes, so the entity still matches if it is leaving. */
+            _connections.push_back(_scene->OnRemoved<T>([this](Scene &scene, Entity entity)
+                                                        {
+                                                            if (scene.Matches<Ts...>(entity))
+                                                                Insert(entity);
+                                                        }));
+            break;
+
+        case CollectorEvent::Updated:
+            /* Updates may come from ParallelEach workers. */
+            _connections.push_back(_scene->OnUpdated<T>([this](Scene &scene, Entity entity)
+                                                        {
+                                                            if (!scene.Matches<Ts...>(entity))
+                                                                return;
+                                                            std::lock_guard lock(_mutex);
+                                                            Insert(entity);
+                                                        }));
+            _connections.push_back(_scene->OnRemoved<T>([this](Scene &, Entity entity) { Erase(entity); }));
+            break;
+        }
+    }
+
+    void Insert(Entity entity)
+    {
+        if (entity.index >= _positions.size())
+            _positions.resize(entity.index + 1, Invalid);
+
+        /* A destroyed entity's handle may share its slot with a newer one; both are kept. */
+        const uint32_t pos = _positions[entity.index];
+        if (pos != Invalid && _entities[pos] == entity)
+            return;
+
+        _positions[entity.index] = static_cast<uint32_t>(_entities.size());
+        _entities.push_back(entity);
+    }
+
+    void Erase(Entity entity)
+    {
+        const uint32_t pos = entity.index < _positions.size() ? _positions[entity.index] : Invalid;
+        if (pos == Invalid || _entities[pos] != entity)
+            return;
+
+        const auto last = static_cast<uint32_t>(_entities.size() - 1);
+        _entities[pos] = _entities[last];
+        _entities.pop_back();
+        _positions[entity.index] = Invalid;
+
+        /* Repoint the moved handle's slot, unless a newer handle owns it. */
+        if (pos != last && _positions[_entities[pos].index] == last)
+            _positions[_entities[pos].index] = pos;
+    }
+
+    Scene *_scene;
+    CollectorEvent _event;
+    std::vector<SignalConnection> _connections;
+    std::vector<Entity> _entities;   ///< Recorded entities.
+    std::vector<uint32_t> _positions; ///< Entity::index -> position in _entities of its newest handle, or Invalid.
+    std::vector<Entity> _draining;   ///< _entities as Each() found it; reused between calls.
+    std::mutex _mutex;               ///< Serializes Updated records from concurrent writers.
+};
+
+} // namespace Assisi::ECS
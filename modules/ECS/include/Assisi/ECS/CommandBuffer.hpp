@@ -0,0 +1,196 @@
+#pragma once
+
+/// @file CommandBuffer.hpp
+/// @brief Deferred structural changes (create/destroy/add/remove) for use during iteration.
+///
+/// Adding, removing or destroying while a Query or Group view is live moves
+/// dense slots under the view.  A CommandBuffer records those operations
+/// instead and applies them later, at a point where no view exists.  Components
+/// are constructed straight into a linear arena of fixed-size blocks, so
+/// recording is a bump allocation and never moves a payload that was already
+/// written.
+///
+/// ThreadCommandBuffers holds one CommandBuffer per Core::JobSystem thread.
+/// Systems record into Local() (also from inside ParallelEach, as long as it
+/// runs on Core::JobSystem::Instance()), and
+/// SystemRegistry plays every buffer back after each phase:
+///
+/// @code
+///   ctx.scene.Query<Health>().ParallelEach(
+///       [&](Entity e, Health &health)
+///       {
+///           if (health.value <= 0.f)
+///               ctx.Commands().Destroy(e);
+///       });
+/// @endcode
+///
+/// Entities handed out by Scene::Reserve() can be recorded against directly;
+/// playback flushes the reservations before anything else.
+///
+/// Playback order: buffer by buffer, the entities recorded with Create() are
+/// allocated (one CreateMany), then every Add/Remove is applied in recording
+/// order; the Destroy() calls of all buffers are applied last, in one
+/// Scene::DestroyMany().  Operations on entities that are dead by
+/// the time they are applied are dropped, and Add on an entity that already
+/// has the component is ignored, just like Scene::Add.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Assisi/ECS/Entity.hpp>
+#include <Assisi/ECS/Scene.hpp>
+
+namespace Assisi::ECS
+{
+
+/// Cache-line aligned so the per-thread buffers of ThreadCommandBuffers never share a line.
+class alignas(64) CommandBuffer
+{
+  public:
+    /// @brief Generation marking a handle returned by Create() that has not been played back yet.
+    ///
+    /// Such a handle is only meaningful to the buffer that returned it.
+    static constexpr uint32_t PendingGeneration = UINT32_MAX;
+
+    /// @brief Bytes per arena block; larger payloads get a block of their own.
+    static constexpr std::size_t BlockSize = 64 * 1024;
+
+    /// @brief Alignment of every arena block, and the largest component alignment supported.
+    static constexpr std::size_t BlockAlignment = 64;
+
+    CommandBuffer() = default;
+    CommandBuffer(const CommandBuffer &)            = delete;
+    CommandBuffer &operator=(const CommandBuffer &) = delete;
+    ~CommandBuffer() { Reset(); }
+
+    /// @brief Records the creation of an entity.
+    /// @return A pending handle usable with Add/Remove/Destroy on this buffer only.
+    Entity Create() { return {_spawnCount++, PendingGeneration}; }
+
+    /// @brief Records the destruction of an entity (live or pending).
+    void Destroy(Entity entity) { _destroyed.push_back(entity); }
+
+    /// @brief Records adding `component` to the entity (live or pending).  Tags take no arena space.
+    template <typename T> void Add(Entity entity, T component = {})
+    {
+        static_assert(alignof(T) <= BlockAlignment, "Component alignment exceeds CommandBuffer::BlockAlignment");
+
+        if constexpr (TagComponent<T>)
+        {
+            _commands.push_back({&ApplyAdd<T>, nullptr, nullptr, entity});
+            return;
+        }
+
+        void *payload = Allocate(sizeof(T), alignof(T));
+        ::new (payload) T(std::move(component));
+        _commands.push_back({&ApplyAdd<T>, std::is_trivially_destructible_v<T> ? nullptr : &DestroyPayload<T>,
+                             payload, entity});
+    }
+
+    /// @brief Records removing the entity's T.
+    template <typename T> void Remove(Entity entity)
+    {
+        _commands.push_back({&ApplyRemove<T>, nullptr, nullptr, entity});
+    }
+
+    /// @brief Returns true if nothing has been recorded since the last playback.
+    bool Empty() const { return _commands.empty() && _destroyed.empty() && _spawnCount == 0; }
+
+    /// @brief Applies everything recorded to `scene` (destroys included) and resets the buffer.
+    void Playback(Scene &scene);
+
+    /// @brief Drops everything recorded, keeping the arena blocks for reuse.
+    void Reset();
+
+  private:
+    friend class ThreadCommandBuffers;
+
+    struct Command
+    {
+        void (*apply)(Scene &scene, void *payload, Entity entity);
+        void (*destroy)(void *payload); ///< nullptr for trivially destructible payloads.
+        void *payload;
+        Entity entity; ///< May be pending until ResolvePending() runs.
+    };
+
+    struct BlockDeleter
+    {
+        void operator()(std::byte *block) const { ::operator delete(block, std::align_val_t{BlockAlignment}); }
+    };
+
+    using Block = std::unique_ptr<std::byte, BlockDeleter>;
+
+    template <typename T> static void ApplyAdd(Scene &scene, void *payload, Entity entity);
+    template <typename T> static void ApplyRemove(Scene &scene, void *payload, Entity entity);
+    template <typename T> static void DestroyPayload(void *payload) { static_cast<T *>(payload)->~T(); }
+
+    /// @brief Bump-allocates `size` bytes from the arena.
+    void *Allocate(std::size_t size, std::size_t align);
+
+    static Block NewBlock(std::size_t size);
+
+    /// @brief Creates the pending entities and rewrites pending handles to the real ones.
+    void ResolvePending(Scene &scene);
+
+    /// @brief Applies the recorded Add/Remove commands in order.
+    void ApplyCommands(Scene &scene);
+
+    std::vector<Command> _commands;
+    std::vector<Entity> _destroyed;
+    std::vector<Entity> _spawned; ///< Real handles of pending entities, by pending index; scratch.
+    uint32_t _spawnCount = 0;
+
+    std::vector<Block> _blocks;      ///< BlockSize blocks, reused across playbacks.
+    std::vector<Block> _largeBlocks; ///< One per oversized payload; freed on Reset().
+    std::size_t _block  = 0;         ///< Block currently bump-allocated from.
+    std::size_t _offset = 0;         ///< Next free byte in _blocks[_block].
+};
+
+/// @brief One CommandBuffer per Core::JobSystem thread (index 0 is every non-worker thread).
+class ThreadCommandBuffers
+{
+  public:
+    /// @brief Sizes the set for the job system's current worker count.
+    ThreadCommandBuffers();
+
+    /// @brief The calling thread's buffer, picked by Core::JobSystem::ThreadIndex().
+    ///
+    /// Only the thread running the systems and the workers of
+    /// Core::JobSystem::Instance() may call this.  ThreadIndex() is 0 for every
+    /// non-worker thread, so any other thread (asset loaders, physics jobs,
+    /// workers of a separate JobSystem) would share a buffer with one of them.
+    CommandBuffer &Local();
+
+    /// @brief Plays back every buffer into `scene`, with one batched DestroyMany at the end.
+    ///
+    /// Must not run concurrently with recording.
+    void Playback(Scene &scene);
+
+  private:
+    std::vector<CommandBuffer> _buffers;
+    std::vector<Entity> _destroyed; ///< Destroys gathered from every buffer; scratch.
+};
+
+template <typename T> void CommandBuffer::ApplyAdd(Scene &scene, void *payload, Entity entity)
+{
+    if (!scene.IsAlive(entity))
+        return;
+
+    if constexpr (TagComponent<T>)
+        (void)scene.Add<T>(entity);
+    else
+        (void)scene.Add<T>(entity, std::move(*static_cast<T *>(payload)));
+}
+
+template <typename T> void CommandBuffer::ApplyRemove(Scene &scene, void *, Entity entity)
+{
+    if (scene.IsAlive(entity))
+        scene.Remove<T>(entity);
+}
+
+} // namespace Assisi::ECS
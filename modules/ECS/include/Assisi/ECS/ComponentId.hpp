@@ -0,0 +1,122 @@
+#pragma once
+
+/// @file ComponentId.hpp
+/// @brief Dense component and resource type ids, and per-entity component signature masks.
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include <Assisi/Core/TypeId.hpp>
+
+namespace Assisi::ECS
+{
+
+using ComponentId = Core::TypeId;
+
+struct ComponentFamily;
+
+/// @brief Returns the process-wide dense id of component type T.
+template <typename T> ComponentId ComponentIdOf() { return Core::TypeIdFamily<ComponentFamily>::Of<T>(); }
+
+using ResourceId = Core::TypeId;
+
+struct ResourceFamily;
+
+/// @brief Returns the process-wide dense id of resource type T (see Scene::SetResource()).
+template <typename T> ResourceId ResourceIdOf() { return Core::TypeIdFamily<ResourceFamily>::Of<T>(); }
+
+/// @brief Fixed-size bitset of component ids: one bit per component type an entity has.
+///
+/// Only the first MaxComponents ids fit in a mask.  Types with larger ids are
+/// still stored normally; they simply fall back to per-pool checks wherever a
+/// mask would otherwise be used (see Fits()).
+struct ComponentMask
+{
+    static constexpr std::size_t MaxComponents = 128;
+    static constexpr std::size_t WordBits      = 64;
+
+    std::array<uint64_t, MaxComponents / WordBits> words{};
+
+    /// @brief Returns true if `id` can be represented in a mask.
+    static constexpr bool Fits(ComponentId id) { return id < MaxComponents; }
+
+    /// @brief Builds the mask of the given component types.  Ids that do not fit are skipped.
+    template <typename... Ts> static ComponentMask Of()
+    {
+        ComponentMask mask;
+        (mask.Set(ComponentIdOf<Ts>()), ...);
+        return mask;
+    }
+
+    void Set(ComponentId id)
+    {
+        if (Fits(id))
+            words[id / WordBits] |= uint64_t{1} << (id % WordBits);
+    }
+
+    void Reset(ComponentId id)
+    {
+        if (Fits(id))
+            words[id / WordBits] &= ~(uint64_t{1} << (id % WordBits));
+    }
+
+    [[nodiscard]] bool Test(ComponentId id) const
+    {
+        return Fits(id) && (words[id / WordBits] >> (id % WordBits) & 1u) != 0;
+    }
+
+    /// @brief Returns true if every bit set in `required` is also set here.
+    [[nodiscard]] bool Contains(const ComponentMask &required) const
+    {
+        for (std::size_t i = 0; i < words.size(); ++i)
+        {
+            if ((words[i] & required.words[i]) != required.words[i])
+                return false;
+        }
+        return true;
+    }
+
+    /// @brief Returns true if this mask and `other` share at least one bit.
+    [[nodiscard]] bool Intersects(const ComponentMask &other) const
+    {
+        for (std::size_t i = 0; i < words.size(); ++i)
+        {
+            if ((words[i] & other.words[i]) != 0)
+                return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool Empty() const
+    {
+        for (uint64_t word : words)
+        {
+            if (word != 0)
+                return false;
+        }
+        return true;
+    }
+
+    /// @brief Calls fn(id) for every set bit, in ascending id order.
+    template <typename Fn> void ForEach(Fn &&fn) const
+    {
+        for (std::size_t i = 0; i < words.size(); ++i)
+        {
+            for (uint64_t word = words[i]; word != 0; word &= word - 1)
+                fn(static_cast<ComponentId>(i * WordBits + static_cast<std::size_t>(std::countr_zero(word))));
+        }
+    }
+
+    ComponentMask &operator|=(const ComponentMask &other)
+    {
+        for (std::size_t i = 0; i < words.size(); ++i)
+            words[i] |= other.words[i];
+        return *this;
+    }
+
+    bool operator==(const ComponentMask &) const = default;
+};
+
+} // namespace Assisi::ECS
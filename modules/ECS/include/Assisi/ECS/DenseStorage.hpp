@@ -0,0 +1,325 @@
+#pragma once
+
+/// @file DenseStorage.hpp
+/// @brief Per-component choice of the container behind SparseSet<T>'s dense array.
+///
+/// The default is std::pmr::vector<T>: contiguous, so groups and Data() can hand
+/// out raw spans, but growing past capacity copies every component at once and
+/// leaves every outstanding T* dangling.  Large pools that grow during play
+/// (spawn waves) can opt into PagedVector instead, which allocates fixed-size
+/// pages and never moves an element to grow:
+///
+/// @code
+///   template <> struct Assisi::ECS::DenseStorage<Bullet> : PagedDense<Bullet>
+///   {
+///   };
+/// @endcode
+///
+/// Paging only removes the growth copy.  Remove() still swaps the last
+/// component into the removed slot, so a pointer to the pool's last element is
+/// invalidated by any removal from the same pool.  Paged pools have no Data()
+/// and cannot back GroupView::Storage().
+///
+/// Empty component types (tags) default to TagVector, which stores nothing but
+/// a count: a tag pool is just its sparse, entity and tick arrays.
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Assisi::ECS
+{
+
+/// @brief Vector-like sequence stored in fixed pages of PageSize elements.  Elements never move on growth.
+///
+/// Offers the subset of the std::pmr::vector interface SparseSet needs,
+/// including its allocator semantics: pages come from the memory resource
+/// given at construction, copies keep the source's resource and assignment
+/// keeps the target's.  Pages are kept by clear() and reused, like a vector's
+/// capacity.
+template <typename T, std::size_t PageSize> class PagedVector
+{
+    static_assert(std::has_single_bit(PageSize), "PagedVector page size must be a power of two");
+
+  public:
+    using value_type     = T;
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+
+    /// @brief Elements per page; capacity grows by this much at a time.
+    static constexpr std::size_t PageLength = PageSize;
+
+    explicit PagedVector(const allocator_type &allocator = {}) : _pages(allocator) {}
+
+    PagedVector(const PagedVector &other) : PagedVector(other, other.get_allocator()) {}
+
+    PagedVector(const PagedVector &other, const allocator_type &allocator) : _pages(allocator) { CopyFrom(other); }
+
+    PagedVector(PagedVector &&other) noexcept
+        : _pages(std::move(other._pages)), _size(std::exchange(other._size, 0))
+    {
+        other._pages.clear();
+    }
+
+    PagedVector &operator=(const PagedVector &other)
+    {
+        if (this == &other)
+            return *this;
+
+        clear();
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            /* Page by page, into the pages already held. */
+            reserve(other._size);
+            for (std::size_t first = 0; first < other._size; first += PageSize)
+                std::memcpy(RawSlot(first), other.RawSlot(first), std::min(PageSize, other._size - first) * sizeof(T));
+            _size = other._size;
+        }
+        else
+        {
+            CopyFrom(other);
+        }
+        return *this;
+    }
+
+    PagedVector &operator=(PagedVector &&other)
+    {
+        if (this == &other)
+            return *this;
+
+        if (get_allocator() != other.get_allocator())
+        {
+            clear();
+            reserve(other._size);
+            for (T &value : other)
+                emplace_back(std::move(value));
+            other.clear();
+            return *this;
+        }
+
+        clear();
+        std::swap(_pages, other._pages);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
+    ~PagedVector()
+    {
+        clear();
+        for (Page *page : _pages)
+            Resource()->deallocate(page, sizeof(Page), alignof(Page));
+    }
+
+    allocator_type get_allocator() const { return _pages.get_allocator(); }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    std::size_t capacity() const { return _pages.size() * PageSize; }
+
+    T &operator[](std::size_t pos) { return *Slot(pos); }
+    const T &operator[](std::size_t pos) const { return *Slot(pos); }
+
+    /// @brief Allocates pages until `count` elements fit.  Existing elements stay where they are.
+    void reserve(std::size_t count)
+    {
+        while (capacity() < count)
+            _pages.push_back(static_cast<Page *>(Resource()->allocate(sizeof(Page), alignof(Page))));
+    }
+
+    template <typename... Args> T &emplace_back(Args &&...args)
+    {
+        reserve(_size + 1);
+        T *slot = ::new (RawSlot(_size)) T(std::forward<Args>(args)...);
+        ++_size;
+        return *slot;
+    }
+
+    void pop_back()
+    {
+        --_size;
+        Slot(_size)->~T();
+    }
+
+    /// @brief Destroys every element, keeping the pages for reuse.
+    void clear()
+    {
+        for (std::size_t pos = 0; pos < _size; ++pos)
+            Slot(pos)->~T();
+        _size = 0;
+    }
+
+    /// @brief Returns every page past the last element to the resource.
+    void shrink_to_fit()
+    {
+        const std::size_t used = (_size + PageSize - 1) / PageSize;
+        for (std::size_t page = used; page < _pages.size(); ++page)
+            Resource()->deallocate(_pages[page], sizeof(Page), alignof(Page));
+        _pages.resize(used);
+        _pages.shrink_to_fit();
+    }
+
+    template <bool Const> struct Iterator
+    {
+        using Owner             = std::conditional_t<Const, const PagedVector, PagedVector>;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T *, T *>;
+        using reference         = std::conditional_t<Const, const T &, T &>;
+
+        Owner *_owner = nullptr;
+        std::size_t _pos = 0;
+
+        reference operator*() const { return (*_owner)[_pos]; }
+        pointer operator->() const { return &(*_owner)[_pos]; }
+
+        Iterator &operator++()
+        {
+            ++_pos;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++_pos;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const { return _pos == other._pos; }
+    };
+
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, _size}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, _size}; }
+
+  private:
+    struct Page
+    {
+        alignas(T) std::byte bytes[sizeof(T) * PageSize];
+    };
+
+    std::pmr::memory_resource *Resource() const { return _pages.get_allocator().resource(); }
+
+    void *RawSlot(std::size_t pos) const { return _pages[pos / PageSize]->bytes + (pos % PageSize) * sizeof(T); }
+    T *Slot(std::size_t pos) const { return std::launder(static_cast<T *>(RawSlot(pos))); }
+
+    void CopyFrom(const PagedVector &other)
+    {
+        reserve(other._size);
+        for (const T &value : other)
+            emplace_back(value);
+    }
+
+    std::pmr::vector<Page *> _pages;
+    std::size_t _size = 0;
+};
+
+/// @brief Dense "array" of an empty type: only a count.  Every element is the same shared T.
+///
+/// Offers the subset of the std::pmr::vector interface SparseSet needs.  All
+/// values of an empty type are interchangeable, so operator[] hands out one
+/// static instance and emplace_back() discards its arguments.
+template <typename T> class TagVector
+{
+    static_assert(std::is_empty_v<T>, "TagVector only holds empty types");
+
+  public:
+    using value_type     = T;
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+
+    explicit TagVector(const allocator_type & = {}) {}
+    TagVector(const TagVector &other, const allocator_type &) : _size(other._size) {}
+
+    allocator_type get_allocator() const { return {}; }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    std::size_t capacity() const { return _size; }
+
+    T &operator[](std::size_t) { return _value; }
+    const T &operator[](std::size_t) const { return _value; }
+
+    void reserve(std::size_t) {}
+    void shrink_to_fit() {}
+
+    template <typename... Args> T &emplace_back(Args &&...)
+    {
+        ++_size;
+        return _value;
+    }
+
+    void pop_back() { --_size; }
+    void clear() { _size = 0; }
+
+    template <bool Const> struct Iterator
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T *, T *>;
+        using reference         = std::conditional_t<Const, const T &, T &>;
+
+        std::size_t _pos = 0;
+
+        reference operator*() const { return _value; }
+        pointer operator->() const { return &_value; }
+
+        Iterator &operator++()
+        {
+            ++_pos;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++_pos;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const { return _pos == other._pos; }
+    };
+
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return {0}; }
+    iterator end() { return {_size}; }
+    const_iterator begin() const { return {0}; }
+    const_iterator end() const { return {_size}; }
+
+  private:
+    static inline T _value{};
+
+    std::size_t _size = 0;
+};
+
+/// @brief Default PagedVector page length for T: as many elements as fit in 16 KB, rounded down to a power of two.
+template <typename T>
+inline constexpr std::size_t DefaultDensePageSize = std::bit_floor(std::max<std::size_t>(1, 16 * 1024 / sizeof(T)));
+
+/// @brief Container SparseSet<T> keeps its dense components in.  Specialize to change it.
+template <typename T> struct DenseStorage
+{
+    using Type = std::conditional_t<std::is_empty_v<T>, TagVector<T>, std::pmr::vector<T>>;
+};
+
+/// @brief Base for DenseStorage specializations selecting pointer-stable paged storage.
+template <typename T, std::size_t PageSize = DefaultDensePageSize<T>> struct PagedDense
+{
+    using Type = PagedVector<T, PageSize>;
+};
+
+} // namespace Assisi::ECS
@@ -0,0 +1,100 @@
+#pragma once
+
+/// @file Group.hpp
+/// @brief Owning groups — pre-packed SparseSets for hot multi-component iteration.
+///
+/// Returned by Scene::Group<Owned...>().  The scene keeps the dense arrays of
+/// every owned pool arranged so that entities having *all* owned components
+/// occupy the same contiguous prefix [0, Size()) in each pool, in the same
+/// order.  Iterating a group is therefore a straight parallel walk over aligned
+/// dense arrays: no Has() checks and no sparse lookups.
+///
+/// The prefix is maintained incrementally by Scene::Add/Remove/Destroy (one
+/// swap per owned pool when an entity enters or leaves the group).  A pool can
+/// be owned by at most one group.
+///
+/// Example:
+/// @code
+///   if (auto group = scene.Group<TransformComponent, MeshRendererComponent>())
+///       for (auto [e, transform, mesh] : *group)
+///           Submit(transform.worldMatrix, mesh);
+/// @endcode
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+
+#include <Assisi/ECS/SparseSet.hpp>
+
+namespace Assisi::ECS
+{
+
+enum class GroupError
+{
+    PoolAlreadyOwned,  ///< One of the requested pools is already owned by a different group.
+    ArchetypeStorage,  ///< Archetype scenes already iterate packed chunks; groups are sparse-set only.
+};
+
+template <typename... Owned> struct GroupView
+{
+    std::tuple<SparseSet<Owned> *...> _pools;
+    const Entity *_entities; ///< Entity array of the first owned pool; identical order in every pool.
+    std::size_t   _size;     ///< Length of the packed prefix.
+
+    struct Sentinel
+    {
+    };
+
+    struct Iterator
+    {
+        const GroupView *_view;
+        std::size_t      _pos;
+
+        std::tuple<Entity, Owned &...> operator*() const
+        {
+            const auto pos = static_cast<uint32_t>(_pos);
+            return std::tuple<Entity, Owned &...>{_view->_entities[_pos],
+                                                  std::get<SparseSet<Owned> *>(_view->_pools)->At(pos)...};
+        }
+
+        Iterator &operator++()
+        {
+            ++_pos;
+            return *this;
+        }
+
+        bool operator==(Sentinel) const { return _pos >= _view->_size; }
+        bool operator!=(Sentinel s) const { return !(*this == s); }
+    };
+
+    Iterator begin() const { return {this, 0}; }
+    Sentinel end() const { return {}; }
+
+    /// @brief Number of entities that have every owned component.
+    std::size_t Size() const { return _size; }
+
+    /// @brief Entities of the group, in iteration order.
+    std::span<const Entity> Entities() const { return {_entities, _size}; }
+
+    /// @brief The packed components of type T, aligned with Entities().  Contiguous (non-paged) pools only.
+    template <typename T> std::span<T> Storage() const { return {std::get<SparseSet<T> *>(_pools)->Data(), _size}; }
+
+    /// @brief Calls fn(entity, owned...) for every entity in the group.
+    template <typename Fn> void Each(Fn &&fn) const
+    {
+        if constexpr ((... && SparseSet<Owned>::Contiguous))
+        {
+            auto data = std::tuple<Owned *...>{std::get<SparseSet<Owned> *>(_pools)->Data()...};
+            for (std::size_t i = 0; i < _size; ++i)
+                fn(_entities[i], std::get<Owned *>(data)[i]...);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < _size; ++i)
+                fn(_entities[i], std::get<SparseSet<Owned> *>(_pools)->At(i)...);
+        }
+    }
+};
+
+} // namespace Assisi::ECS
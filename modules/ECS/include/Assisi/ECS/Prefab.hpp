@@ -0,0 +1,96 @@
+#pragma once
+
+/// @file Prefab.hpp
+/// @brief A template entity set that can be stamped into a scene many times in one call.
+///
+/// Spawning a composite object (a body with its children, a turret with its
+/// barrel) by hand costs one Create() and one Add() per component, and every
+/// Add() grows its pool on its own.  A Prefab keeps the object as a small
+/// sparse-set template scene and instantiates it pool by pool: all entities
+/// of every copy come from one Scene::CreateMany(), and each component type
+/// is appended for every copy with one Scene::AddMany(), which reserves the
+/// pool's dense capacity once.
+///
+/// @code
+///   ECS::Prefab turret;
+///   const ECS::Entity base   = turret.Template().Create();
+///   const ECS::Entity barrel = turret.Template().Create();
+///   (void)turret.Template().Add<Transform>(base, {});
+///   (void)turret.Template().Add<Transform>(barrel, {});
+///   (void)turret.Template().Add<ParentComponent>(barrel, {base});
+///
+///   auto spawned = turret.Instantiate(scene, 10'000); // 20'000 entities
+/// @endcode
+///
+/// Entity handles held by components are rewritten per copy: a reflected
+/// EntityRef field (see Core::Reflect::FieldType) that points at one of the
+/// template's entities points at the same copy's entity afterwards, so
+/// ParentComponent and friends stay inside their instance.  Handles to
+/// anything else are copied unchanged, so a template should only refer to
+/// its own entities (or NullEntity).  Unreflected components are copied
+/// byte for byte.
+///
+/// Instances raise Added signals and join groups like any other AddMany().
+/// Components past their pool's budget are skipped, as AddMany() does.
+/// Templates can also be built from a live scene with FromEntities(), or
+/// from a level file with Runtime::SceneSerializer::LoadPrefabFromFile().
+
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <Assisi/ECS/Entity.hpp>
+#include <Assisi/ECS/Scene.hpp>
+
+namespace Assisi::ECS
+{
+
+enum class PrefabError
+{
+    ArchetypeStorage, ///< FromEntities() was given an archetype scene; only sparse-set scenes can be copied from.
+    NotCopyable,      ///< A component of the copied entities is not copy constructible.  Nothing was changed.
+    SizeMismatch,     ///< The output span is not a multiple of EntityCount().
+};
+
+class Prefab
+{
+  public:
+    /// @brief Creates a prefab with an empty template.
+    Prefab() : _template(std::make_unique<Scene>()) {}
+
+    /// @brief Copies the live entities of `entities`, with their components, into a new template.
+    ///
+    /// Dead and duplicate handles are skipped.  Handles between the copied
+    /// entities are remapped to their template counterparts; handles to any
+    /// other entity of `source` become NullEntity.
+    static std::expected<Prefab, PrefabError> FromEntities(const Scene &source, std::span<const Entity> entities);
+
+    /// @brief The template scene.  Build or edit the prefab by changing it like any scene.
+    Scene &Template() { return *_template; }
+    const Scene &Template() const { return *_template; }
+
+    /// @brief Number of entities one instance creates.
+    std::size_t EntityCount() const { return _template->AliveCount(); }
+
+    /// @brief Instantiates out.size() / EntityCount() copies into `target`, writing their entities to `out`.
+    ///
+    /// `out` is copy-major: copy k's entities are out[k * EntityCount()] onwards,
+    /// in the template's index order.
+    std::expected<void, PrefabError> Instantiate(Scene &target, std::span<Entity> out) const;
+
+    /// @brief Instantiates `count` copies into `target` and returns their entities, copy-major.
+    std::expected<std::vector<Entity>, PrefabError> Instantiate(Scene &target, std::size_t count) const;
+
+  private:
+    /// @brief Returns true if every component the sources have can be copied.
+    static bool Copyable(const Scene &source, std::span<const Entity> sources);
+
+    /// @brief Runs every pool of `source` through `map` into `target`.
+    static void CopyComponents(const Scene &source, Scene &target, const Scene::PrefabMapping &map);
+
+    std::unique_ptr<Scene> _template; ///< Heap-allocated so Prefab moves without moving the scene.
+};
+
+} // namespace Assisi::ECS
@@ -5,26 +5,390 @@
 ///
 /// Returned by Scene::Query<Ts...>(). Iterates the smallest matching pool and skips
 /// entities absent from the others, yielding (Entity, Ts&...) as a structured binding.
+/// Membership is tested against the registry's per-entity ComponentMask when
+/// available, so rejecting a candidate costs one mask AND instead of a lookup per pool.
+/// In archetype-storage scenes the view instead walks the columns of every matching
+/// chunk in order, with no per-entity lookups.
+///
+/// Besides plain component types, Ts may contain these terms:
+///   - Changed<T>:     requires T, added or marked changed after the `since` tick passed to Query().
+///   - Added<T>:       requires T, added after `since`.
+///   - Exclude<Us...>: the entity has none of Us.
+///   - Optional<T>:    T is not required and is yielded as T* (nullptr when absent).
+/// Components with a SoaLayout are yielded as SoaRef<T> instead of T& (and
+/// as an empty SoaRef<T> instead of nullptr under Optional).
+/// Changed, Added and Exclude add nothing to the yielded tuple, and neither do
+/// tags (empty component types): they are required like any component but
+/// act as pure filters, so `Query<Position, Selected>()` yields (Entity,
+/// Position&).  Optional<Tag> still yields a pointer, usable as a flag.  All
+/// pool pointers are resolved once when the view is built.
+///
+/// EachChunk() hands out runs of matches instead of rows: fn(entities,
+/// spans...) gets one std::span per plain component and one SoaSpan per SoA
+/// component (a span per field), all indexed alike, so the loop body is a
+/// plain indexed loop the compiler can vectorize.  In
+/// sparse-set scenes a run lasts while the matches sit at consecutive
+/// positions of every spanned pool (a single pool, an owning group, or pools
+/// filled in the same order); in archetype scenes each chunk is one run.
 ///
 /// Example:
 /// @code
 ///   for (auto [e, pos, vel] : scene.Query<Position, Velocity>())
 ///       pos.x += vel.x;
+///
+///   scene.Query<Position, Velocity>().EachChunk(
+///       [](std::span<const Entity>, std::span<Position> pos, std::span<const Velocity> vel)
+///       {
+///           for (std::size_t i = 0; i < pos.size(); ++i)
+///               pos[i].x += vel[i].x;
+///       });
+///
+///   scene.Query<Position, Velocity>().ParallelEach(
+///       [](Entity, Position &pos, const Velocity &vel) { pos.x += vel.x; });
+///
+///   // Roots only; RigidBody may or may not be present.
+///   for (auto [e, transform, body] : scene.Query<Transform, Optional<RigidBody>, Exclude<Parent>>())
+///       if (body) ...
+///
+///   // Only entities whose Transform changed since this system last ran.
+///   for (auto [e, transform] : scene.Query<Transform, Changed<Transform>>(ctx.lastRunTick))
+///       Upload(e, transform);
 /// @endcode
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <span>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <Assisi/Core/JobSystem.hpp>
+#include <Assisi/ECS/Archetype.hpp>
+#include <Assisi/ECS/ComponentId.hpp>
 #include <Assisi/ECS/SparseSet.hpp>
 
 namespace Assisi::ECS
 {
 
+/// @brief Query filter: matches entities whose T was added or changed after the query's `since` tick.
+template <typename T> struct Changed
+{
+};
+
+/// @brief Query filter: matches entities whose T was added after the query's `since` tick.
+template <typename T> struct Added
+{
+};
+
+/// @brief Query filter: matches only entities that have none of Us.
+template <typename... Us> struct Exclude
+{
+};
+
+/// @brief Query term: T is not required; yielded as T*, nullptr when the entity has none.
+template <typename T> struct Optional
+{
+};
+
+/// @brief How one element of a Query<Ts...> pack is resolved, tested and yielded.
+///
+/// Every term resolves its pool pointer(s) once when the view is built:
+///   - Storage / Resolve(get): the pool pointer(s) the term reads.
+///   - Required: the term's component must be present; required terms pick the primary pool.
+///   - AddToMask(): bits the term contributes to the view's required/excluded masks.
+///   - Present(): presence test used when masks are unavailable.
+///   - Filter(): extra per-entity test (change ticks); always applied.
+///   - FromPool() / FromColumn(): what the term adds to the yielded row.
+///   - Matches() / ChunkColumn(): the archetype-storage equivalents.
+///   - Chunkable: the term may appear in an EachChunk() query.
+///   - Spanned / PoolSpan() / ColumnSpan(): whether and how EachChunk() hands the term out as a span.
+///
+/// The primary template is a plain component: required, yielded as T&.
+template <typename T> struct QueryTerm
+{
+    using Storage = SparseSet<T> *;
+    using Column  = T *;
+
+    static constexpr bool Required = true;
+    static constexpr bool Chunkable = SparseSet<T>::Contiguous; ///< Paged pools have no span to hand out.
+    static constexpr bool Spanned = true;
+
+    template <typename Get> static Storage Resolve(Get &&get) { return get(std::type_identity<T>{}); }
+
+    static bool FitsMask() { return ComponentMask::Fits(ComponentIdOf<T>()); }
+    static void AddToMask(ComponentMask &required, ComponentMask &) { required.Set(ComponentIdOf<T>()); }
+
+    static bool Present(Storage pool, Entity entity) { return pool->Has(entity); }
+    static bool Filter(Storage, Entity, Tick) { return true; }
+    static std::tuple<T &> FromPool(Storage pool, Entity entity) { return {*pool->Get(entity)}; }
+
+    static bool Matches(const Archetype &archetype) { return archetype.Has(typeid(T)); }
+    static Column ChunkColumn(const Archetype &archetype, std::size_t chunk)
+    {
+        return static_cast<T *>(
+            archetype.Column(chunk, static_cast<std::size_t>(archetype.ColumnIndex(typeid(T)))));
+    }
+    static std::tuple<T &> FromColumn(Column column, std::size_t row) { return {column[row]}; }
+
+    static std::tuple<std::span<T>> PoolSpan(Storage pool, uint32_t first, std::size_t count)
+    {
+        return {std::span<T>(pool->Data() + first, count)};
+    }
+    static std::tuple<std::span<T>> ColumnSpan(Column column, std::size_t count) { return {{column, count}}; }
+};
+
+/// SoA components (see SoaLayout.hpp) are yielded as SoaRef<T>.  Archetype
+/// chunks never store them, so in archetype scenes they match nothing.
+template <typename T>
+    requires SoaComponent<T>
+struct QueryTerm<T>
+{
+    using Storage = SparseSet<T> *;
+    using Column  = T *; ///< Always nullptr; only present so Changed/Added/Optional share the interface.
+
+    static constexpr bool Required = true;
+    static constexpr bool Chunkable = true;
+    static constexpr bool Spanned = true; ///< Handed out as a SoaSpan<T>: one span per field.
+
+    template <typename Get> static Storage Resolve(Get &&get) { return get(std::type_identity<T>{}); }
+
+    static bool FitsMask() { return ComponentMask::Fits(ComponentIdOf<T>()); }
+    static void AddToMask(ComponentMask &required, ComponentMask &) { required.Set(ComponentIdOf<T>()); }
+
+    static bool Present(Storage pool, Entity entity) { return pool->Has(entity); }
+    static bool Filter(Storage, Entity, Tick) { return true; }
+    static std::tuple<SoaRef<T>> FromPool(Storage pool, Entity entity) { return {pool->Get(entity)}; }
+
+    static bool Matches(const Archetype &) { return false; }
+    static Column ChunkColumn(const Archetype &, std::size_t) { return nullptr; }
+    static std::tuple<SoaRef<T>> FromColumn(Column, std::size_t) { return {}; }
+
+    static std::tuple<SoaSpan<T>> PoolSpan(Storage pool, uint32_t first, std::size_t count)
+    {
+        return {SoaSpan<T>{pool, first, count}};
+    }
+    static std::tuple<SoaSpan<T>> ColumnSpan(Column, std::size_t) { return {}; }
+};
+
+/// Tags (empty components) are required but yield nothing: there is no value to read.
+template <typename T>
+    requires TagComponent<T>
+struct QueryTerm<T>
+{
+    using Storage = SparseSet<T> *;
+    using Column  = T *; ///< Always nullptr; only present so Changed/Added/Optional share the interface.
+
+    static constexpr bool Required = true;
+    static constexpr bool Chunkable = true;
+    static constexpr bool Spanned = false;
+
+    template <typename Get> static Storage Resolve(Get &&get) { return get(std::type_identity<T>{}); }
+
+    static bool FitsMask() { return ComponentMask::Fits(ComponentIdOf<T>()); }
+    static void AddToMask(ComponentMask &required, ComponentMask &) { required.Set(ComponentIdOf<T>()); }
+
+    static bool Present(Storage pool, Entity entity) { return pool->Has(entity); }
+    static bool Filter(Storage, Entity, Tick) { return true; }
+    static std::tuple<> FromPool(Storage, Entity) { return {}; }
+
+    static bool Matches(const Archetype &archetype) { return archetype.Has(typeid(T)); }
+    static Column ChunkColumn(const Archetype &, std::size_t) { return nullptr; }
+    static std::tuple<> FromColumn(Column, std::size_t) { return {}; }
+
+    static std::tuple<> PoolSpan(Storage, uint32_t, std::size_t) { return {}; }
+    static std::tuple<> ColumnSpan(Column, std::size_t) { return {}; }
+};
+
+template <typename T> struct QueryTerm<Changed<T>> : QueryTerm<T>
+{
+    static constexpr bool Chunkable = true;
+    static constexpr bool Spanned = false;
+
+    static bool Filter(SparseSet<T> *pool, Entity entity, Tick since)
+    {
+        return IsNewerTick(pool->Ticks(entity)->changed, since);
+    }
+    static std::tuple<> FromPool(SparseSet<T> *, Entity) { return {}; }
+    static std::tuple<> FromColumn(T *, std::size_t) { return {}; }
+    static std::tuple<> PoolSpan(SparseSet<T> *, uint32_t, std::size_t) { return {}; }
+    static std::tuple<> ColumnSpan(T *, std::size_t) { return {}; }
+};
+
+template <typename T> struct QueryTerm<Added<T>> : QueryTerm<T>
+{
+    static constexpr bool Chunkable = true;
+    static constexpr bool Spanned = false;
+
+    static bool Filter(SparseSet<T> *pool, Entity entity, Tick since)
+    {
+        return IsNewerTick(pool->Ticks(entity)->added, since);
+    }
+    static std::tuple<> FromPool(SparseSet<T> *, Entity) { return {}; }
+    static std::tuple<> FromColumn(T *, std::size_t) { return {}; }
+    static std::tuple<> PoolSpan(SparseSet<T> *, uint32_t, std::size_t) { return {}; }
+    static std::tuple<> ColumnSpan(T *, std::size_t) { return {}; }
+};
+
+template <typename T> struct QueryTerm<Optional<T>> : QueryTerm<T>
+{
+    static constexpr bool Required = false;
+    static constexpr bool Chunkable = false; ///< A run cannot mix present and absent components.
+    static constexpr bool Spanned = false;
+
+    static bool FitsMask() { return true; }
+    static void AddToMask(ComponentMask &, ComponentMask &) {}
+
+    static bool Present(SparseSet<T> *, Entity) { return true; }
+    static std::tuple<ComponentRef<T>> FromPool(SparseSet<T> *pool, Entity entity)
+    {
+        return {pool ? pool->Get(entity) : ComponentRef<T>{}};
+    }
+
+    static bool Matches(const Archetype &) { return true; }
+    static T *ChunkColumn(const Archetype &archetype, std::size_t chunk)
+    {
+        const int column = archetype.ColumnIndex(typeid(T));
+        return column < 0 ? nullptr : static_cast<T *>(archetype.Column(chunk, static_cast<std::size_t>(column)));
+    }
+    static std::tuple<ComponentRef<T>> FromColumn(T *column, std::size_t row)
+    {
+        if constexpr (SoaComponent<T>)
+            return {};
+        else
+            return {column ? column + row : nullptr};
+    }
+};
+
+template <typename... Us> struct QueryTerm<Exclude<Us...>>
+{
+    using Storage = std::tuple<SparseSet<Us> *...>;
+    using Column  = std::tuple<>;
+
+    static constexpr bool Required = false;
+    static constexpr bool Chunkable = true;
+    static constexpr bool Spanned = false;
+
+    template <typename Get> static Storage Resolve(Get &&get) { return {get(std::type_identity<Us>{})...}; }
+
+    static bool FitsMask() { return (... && ComponentMask::Fits(ComponentIdOf<Us>())); }
+    static void AddToMask(ComponentMask &, ComponentMask &excluded) { (excluded.Set(ComponentIdOf<Us>()), ...); }
+
+    static bool Present(const Storage &pools, Entity entity)
+    {
+        return std::apply([&](auto *...pool) { return !(... || (pool && pool->Has(entity))); }, pools);
+    }
+    static bool Filter(const Storage &, Entity, Tick) { return true; }
+    static std::tuple<> FromPool(const Storage &, Entity) { return {}; }
+
+    static bool Matches(const Archetype &archetype) { return !(... || archetype.Has(typeid(Us))); }
+    static Column ChunkColumn(const Archetype &, std::size_t) { return {}; }
+    static std::tuple<> FromColumn(Column, std::size_t) { return {}; }
+
+    static std::tuple<> PoolSpan(const Storage &, uint32_t, std::size_t) { return {}; }
+    static std::tuple<> ColumnSpan(Column, std::size_t) { return {}; }
+};
+
+/// @brief One archetype chunk matched by a query: packed entities plus one column per term.
+template <typename... Ts> struct ChunkSlice
+{
+    const Entity                                *entities;
+    std::size_t                                  count;
+    std::tuple<typename QueryTerm<Ts>::Column...> columns;
+};
+
 template <typename... Ts> struct QueryView
 {
-    std::tuple<SparseSet<Ts> *...> _pools;
-    const std::vector<Entity> *_primary; ///< Entity list of the smallest pool; nullptr = no results.
+    /// @brief Target number of entities per task used by ParallelEach().
+    static constexpr std::size_t DefaultParallelChunk = 1024;
+
+    static_assert((... || QueryTerm<Ts>::Required), "A query needs at least one required component");
+
+    using Pools = std::tuple<typename QueryTerm<Ts>::Storage...>;
+
+    /// @brief The tuple yielded per entity: the entity, then T& per plain term and T* per Optional<T>
+    ///        (SoaRef<T> for SoA components; nothing for tags).
+    using Row = decltype(std::tuple_cat(std::declval<std::tuple<Entity>>(),
+                                        QueryTerm<Ts>::FromPool(std::declval<typename QueryTerm<Ts>::Storage>(),
+                                                                Entity{})...));
+
+    Pools _pools;
+    const std::pmr::vector<Entity> *_primary; ///< Entity list of the smallest pool; nullptr = no results.
+    std::vector<ChunkSlice<Ts...>> _chunks; ///< Matching chunks in archetype storage; empty otherwise.
+    const std::vector<ComponentMask> *_masks; ///< Registry masks by entity index; nullptr = test each pool.
+    ComponentMask _required;                  ///< Components every match has, compared against _masks.
+    ComponentMask _excluded;                  ///< Components no match has.
+    Tick _since;                              ///< Reference tick for Changed/Added filters.
+
+    /// @brief Builds a sparse-set view.  get(std::type_identity<T>) returns the pool for T or nullptr.
+    template <typename Get>
+    static QueryView FromPools(Get &&get, const std::vector<ComponentMask> *masks, Tick since)
+    {
+        QueryView view{{QueryTerm<Ts>::Resolve(get)...}, nullptr, {}, nullptr, {}, {}, since};
+        view.SelectPrimary();
+
+        /* Prefilter candidates with one mask test when every id fits in a mask. */
+        if ((... && QueryTerm<Ts>::FitsMask()))
+        {
+            view._masks = masks;
+            (QueryTerm<Ts>::AddToMask(view._required, view._excluded), ...);
+        }
+        return view;
+    }
+
+    /// @brief Builds an archetype view over every non-empty chunk whose signature satisfies all terms.
+    static QueryView FromArchetypes(const ArchetypeStorage &storage, Tick since)
+    {
+        QueryView view{{}, nullptr, {}, nullptr, {}, {}, since};
+        storage.ForEachMatchingChunk(&MatchesArchetype,
+                                     [&](const Archetype &archetype, std::size_t chunk)
+                                     { view.AddChunk(archetype, chunk); });
+        return view;
+    }
+
+    /// @brief True if entities of `archetype` satisfy every term.
+    static bool MatchesArchetype(const Archetype &archetype) { return (... && QueryTerm<Ts>::Matches(archetype)); }
+
+    /// @brief Points the view at the smallest required pool, or at nothing if a required pool is missing.
+    ///
+    /// Pool sizes change between frames, so views kept across calls
+    /// (CachedQuery) re-run this instead of resolving the pools again.
+    void SelectPrimary()
+    {
+        /* Drive iteration from the smallest required pool to minimise skipped
+           entities.  A missing required pool means nothing can match. */
+        bool missing = false;
+        std::size_t minSize = SIZE_MAX;
+        const std::pmr::vector<Entity> *primary = nullptr;
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            auto consider = [&]<std::size_t I>(std::integral_constant<std::size_t, I>)
+            {
+                if constexpr (QueryTerm<std::tuple_element_t<I, std::tuple<Ts...>>>::Required)
+                {
+                    const auto *pool = std::get<I>(_pools);
+                    if (!pool)
+                        missing = true;
+                    else if (pool->Size() < minSize)
+                    {
+                        minSize = pool->Size();
+                        primary = &pool->Entities();
+                    }
+                }
+            };
+            (consider(std::integral_constant<std::size_t, Is>{}), ...);
+        }(std::index_sequence_for<Ts...>{});
+
+        _primary = missing ? nullptr : primary;
+    }
+
+    /// @brief Appends one (non-empty) chunk of a matching archetype to the view.
+    void AddChunk(const Archetype &archetype, std::size_t chunk)
+    {
+        _chunks.push_back(
+            {archetype.Entities(chunk), archetype.ChunkSize(chunk), {QueryTerm<Ts>::ChunkColumn(archetype, chunk)...}});
+    }
 
     struct Sentinel
     {
@@ -32,45 +396,319 @@ template <typename... Ts> struct QueryView
 
     struct Iterator
     {
-        const std::vector<Entity> *_entities;
+        const Entity *_entities; ///< Primary pool's entity array (sparse-set iteration only).
         std::size_t _pos;
-        std::tuple<SparseSet<Ts> *...> _pools;
+        std::size_t _end;        ///< One past the last primary position this iterator may visit.
+        Pools _pools;
+        const ChunkSlice<Ts...> *_slice;    ///< Current chunk; nullptr = sparse-set iteration.
+        const ChunkSlice<Ts...> *_sliceEnd;
+        const std::vector<ComponentMask> *_masks;
+        ComponentMask _required;
+        ComponentMask _excluded;
+        Tick _since;
 
-        bool HasAll(Entity e) const { return (... && std::get<SparseSet<Ts> *>(_pools)->Has(e)); }
+        bool HasAll(Entity e) const { return HasAll(e, std::index_sequence_for<Ts...>{}); }
 
         void SkipInvalid()
         {
-            while (_pos < _entities->size() && !HasAll((*_entities)[_pos]))
+            while (_pos < _end && !HasAll(_entities[_pos]))
                 ++_pos;
         }
 
-        std::tuple<Entity, Ts &...> operator*() const
-        {
-            Entity e = (*_entities)[_pos];
-            return std::tuple<Entity, Ts &...>{e, *std::get<SparseSet<Ts> *>(_pools)->Get(e)...};
-        }
+        Row operator*() const { return Fetch(std::index_sequence_for<Ts...>{}); }
 
         Iterator &operator++()
         {
             ++_pos;
+            if (_slice)
+            {
+                /* Chunk slices are never empty, so one step reaches the next row. */
+                if (_pos == _slice->count)
+                {
+                    ++_slice;
+                    _pos = 0;
+                }
+                return *this;
+            }
             SkipInvalid();
             return *this;
         }
 
-        bool operator==(Sentinel) const { return _pos >= _entities->size(); }
+        bool operator==(Sentinel) const { return _slice ? _slice == _sliceEnd : _pos >= _end; }
         bool operator!=(Sentinel s) const { return !(*this == s); }
+
+      private:
+        template <std::size_t... Is> bool HasAll(Entity e, std::index_sequence<Is...>) const
+        {
+            bool present = false;
+            if (_masks)
+            {
+                present = e.index < _masks->size() && (*_masks)[e.index].Contains(_required) &&
+                          !(*_masks)[e.index].Intersects(_excluded);
+            }
+            else
+            {
+                present = (... && QueryTerm<Ts>::Present(std::get<Is>(_pools), e));
+            }
+            return present && (... && QueryTerm<Ts>::Filter(std::get<Is>(_pools), e, _since));
+        }
+
+        template <std::size_t... Is> Row Fetch(std::index_sequence<Is...>) const
+        {
+            if (_slice)
+                return std::tuple_cat(std::tuple<Entity>{_slice->entities[_pos]},
+                                      QueryTerm<Ts>::FromColumn(std::get<Is>(_slice->columns), _pos)...);
+
+            const Entity e = _entities[_pos];
+            return std::tuple_cat(std::tuple<Entity>{e}, QueryTerm<Ts>::FromPool(std::get<Is>(_pools), e)...);
+        }
+    };
+
+    /// @brief A contiguous part of the view handed to ParallelForChunks() callbacks.
+    ///
+    /// Iterates exactly like the view itself: `for (auto [e, pos, vel] : range)`.
+    struct Range
+    {
+        Iterator _first;
+
+        Iterator begin() const { return _first; }
+        Sentinel end() const { return {}; }
     };
 
-    Iterator begin()
+    Iterator begin() { return _chunks.empty() ? PrimaryIterator(0, PrimarySize()) : ChunkIterator(0, _chunks.size()); }
+
+    Sentinel end() const { return {}; }
+
+    /// @brief Calls fn(entities, spans...) for each run of matches stored contiguously in every spanned pool.
+    ///
+    /// `entities` is a std::span<const Entity>; after it comes one std::span<T>
+    /// per plain component term and one SoaSpan<T> per SoA term (its
+    /// Column<&T::x>() is a std::span of that field), in query order, each as
+    /// long as `entities`.  Tags, Changed, Added and Exclude filter as usual but
+    /// add no span; Optional and paged pools are not supported.  Runs are
+    /// visited in the order the view iterates.
+    ///
+    /// In sparse-set scenes each run costs one sparse lookup per spanned pool
+    /// to start, then one entity compare per pool and match while it lasts;
+    /// a match out of step with any pool ends the run.  When every term is a
+    /// plain component, an entity found at the same offset of every pool has
+    /// them all, so runs are measured by comparing the pools' entity arrays
+    /// with no membership test per entity.  Pools filled in unrelated orders
+    /// give runs of one, where plain iteration is cheaper.  Same structural
+    /// rules as iterating the view.
+    template <typename Fn> void EachChunk(Fn &&fn)
+    {
+        static_assert((... && QueryTerm<Ts>::Chunkable),
+                      "EachChunk() takes contiguous plain or SoA components, tags, Changed, Added and Exclude only");
+
+        if (!_chunks.empty())
+        {
+            for (const ChunkSlice<Ts...> &slice : _chunks)
+                EmitChunk(fn, slice, std::index_sequence_for<Ts...>{});
+            return;
+        }
+
+        if constexpr ((... && QueryTerm<Ts>::Spanned))
+        {
+            for (std::size_t pos = 0; pos < PrimarySize();)
+            {
+                const RunPositions first = Locate((*_primary)[pos], std::index_sequence_for<Ts...>{});
+                const std::size_t length = AlignedLength(first, pos, std::index_sequence_for<Ts...>{});
+                if (length == 0)
+                {
+                    ++pos;
+                    continue;
+                }
+                EmitRun(fn, pos, first, length, std::index_sequence_for<Ts...>{});
+                pos += length;
+            }
+            return;
+        }
+
+        RunPositions first{};
+        std::size_t runStart = 0;
+        std::size_t runLength = 0;
+        for (Iterator it = PrimaryIterator(0, PrimarySize()); it != Sentinel{}; ++it)
+        {
+            const Entity entity = it._entities[it._pos];
+            if (runLength != 0 && it._pos == runStart + runLength &&
+                Continues(first, runLength, entity, std::index_sequence_for<Ts...>{}))
+            {
+                ++runLength;
+                continue;
+            }
+
+            if (runLength != 0)
+                EmitRun(fn, runStart, first, runLength, std::index_sequence_for<Ts...>{});
+            runStart = it._pos;
+            runLength = 1;
+            first = Locate(entity, std::index_sequence_for<Ts...>{});
+        }
+        if (runLength != 0)
+            EmitRun(fn, runStart, first, runLength, std::index_sequence_for<Ts...>{});
+    }
+
+    /// @name Parallel iteration
+    /// All of these block until every matching entity has been visited, running
+    /// the callback on Core::JobSystem workers and the calling thread.  The
+    /// overloads without a job system use Core::JobSystem::Instance(); the
+    /// others run on `jobs` (e.g. a pool of a given size, for scaling tests).
+    /// Per-thread state indexed by JobSystem::ThreadIndex(), such as
+    /// ctx.Commands(), is sized for Instance() and must not be used from
+    /// another pool's workers.
+    ///
+    /// Contract for the callback:
+    ///   - Each matching entity is visited exactly once, by one thread, so writing
+    ///     to the components handed to the callback is safe.
+    ///   - Reading any component of another entity is safe only if no thread of the
+    ///     same pass writes that component type.
+    ///   - No structural changes: Create, Destroy, Add or Remove on the scene (or on
+    ///     any pool the view references) are not allowed until the call returns.
+    ///   - Writes to anything else shared (containers, counters, other scenes)
+    ///     need their own synchronisation; prefer per-range accumulators in
+    ///     ParallelForChunks() merged after the call.
+    ///   - Visit order is unspecified.
+    ///@{
+
+    /// @brief Calls fn(range) for sub-ranges of roughly `chunkSize` primary-pool entries.
+    ///
+    /// In archetype storage whole chunks are the unit of work; several are batched
+    /// per call so that a range covers about `chunkSize` rows.
+    template <typename Fn> void ParallelForChunks(Core::JobSystem &jobs, std::size_t chunkSize, Fn &&fn)
     {
-        static const std::vector<Entity> empty;
-        const std::vector<Entity> *src = _primary ? _primary : &empty;
-        Iterator it{src, 0, _pools};
+        if (!_chunks.empty())
+        {
+            const std::size_t perTask = std::max<std::size_t>(1, chunkSize / _chunks.front().count);
+            jobs.ParallelFor(_chunks.size(), perTask,
+                             [&](std::size_t begin, std::size_t end) { fn(Range{ChunkIterator(begin, end)}); });
+            return;
+        }
+
+        jobs.ParallelFor(PrimarySize(), chunkSize,
+                         [&](std::size_t begin, std::size_t end) { fn(Range{PrimaryIterator(begin, end)}); });
+    }
+
+    template <typename Fn> void ParallelForChunks(std::size_t chunkSize, Fn &&fn)
+    {
+        ParallelForChunks(Core::JobSystem::Instance(), chunkSize, std::forward<Fn>(fn));
+    }
+
+    /// @brief Calls fn(entity, components...) for every matching entity, in parallel.
+    template <typename Fn> void ParallelEach(Core::JobSystem &jobs, Fn &&fn)
+    {
+        ParallelForChunks(jobs, DefaultParallelChunk,
+                          [&](Range range)
+                          {
+                              for (auto &&row : range)
+                                  std::apply(fn, row);
+                          });
+    }
+
+    template <typename Fn> void ParallelEach(Fn &&fn)
+    {
+        ParallelEach(Core::JobSystem::Instance(), std::forward<Fn>(fn));
+    }
+    ///@}
+
+  private:
+    /// Dense position of a run's first match in each spanned term's pool (unused for other terms).
+    using RunPositions = std::array<uint32_t, sizeof...(Ts)>;
+
+    std::size_t PrimarySize() const { return _primary ? _primary->size() : 0; }
+
+    /// Dense position of `entity` in every spanned pool.
+    template <std::size_t... Is> RunPositions Locate(Entity entity, std::index_sequence<Is...>) const
+    {
+        RunPositions positions{};
+        const auto locate = [&]<std::size_t I>(std::integral_constant<std::size_t, I>)
+        {
+            if constexpr (QueryTerm<std::tuple_element_t<I, std::tuple<Ts...>>>::Spanned)
+                positions[I] = std::get<I>(_pools)->IndexOf(entity);
+        };
+        (locate(std::integral_constant<std::size_t, Is>{}), ...);
+        return positions;
+    }
+
+    /// True if `entity` sits right after the run's last match in every spanned pool.
+    template <std::size_t... Is>
+    bool Continues(const RunPositions &first, std::size_t length, Entity entity, std::index_sequence<Is...>) const
+    {
+        const auto follows = [&]<std::size_t I>(std::integral_constant<std::size_t, I>)
+        {
+            if constexpr (QueryTerm<std::tuple_element_t<I, std::tuple<Ts...>>>::Spanned)
+            {
+                const auto &entities = std::get<I>(_pools)->Entities();
+                const std::size_t pos = first[I] + length;
+                return pos < entities.size() && entities[pos] == entity;
+            }
+            else
+            {
+                return true;
+            }
+        };
+        return (... && follows(std::integral_constant<std::size_t, Is>{}));
+    }
+
+    /// Number of primary entities from `start` on that also follow each other in every pool from `first`;
+    /// 0 if a pool lacks the entity at `start`.  Plain-component queries only.
+    template <std::size_t... Is>
+    std::size_t AlignedLength(const RunPositions &first, std::size_t start, std::index_sequence<Is...>) const
+    {
+        const Entity *entities = _primary->data() + start;
+        std::size_t length = _primary->size() - start;
+        const auto clip = [&]<std::size_t I>(std::integral_constant<std::size_t, I>)
+        {
+            const auto &other = std::get<I>(_pools)->Entities();
+            if (length == 0 || first[I] == SparsePages::Invalid)
+            {
+                length = 0;
+                return;
+            }
+            length = std::min(length, other.size() - first[I]);
+            const Entity *theirs = other.data() + first[I];
+            if (theirs != entities) /* the primary pool itself */
+                length = static_cast<std::size_t>(std::mismatch(entities, entities + length, theirs).first - entities);
+        };
+        (clip(std::integral_constant<std::size_t, Is>{}), ...);
+        return length;
+    }
+
+    template <typename Fn, std::size_t... Is>
+    void EmitRun(Fn &fn, std::size_t start, const RunPositions &first, std::size_t length,
+                 std::index_sequence<Is...>) const
+    {
+        std::apply(fn, std::tuple_cat(std::tuple<std::span<const Entity>>{{_primary->data() + start, length}},
+                                      QueryTerm<Ts>::PoolSpan(std::get<Is>(_pools), first[Is], length)...));
+    }
+
+    template <typename Fn, std::size_t... Is>
+    static void EmitChunk(Fn &fn, const ChunkSlice<Ts...> &slice, std::index_sequence<Is...>)
+    {
+        std::apply(fn, std::tuple_cat(std::tuple<std::span<const Entity>>{{slice.entities, slice.count}},
+                                      QueryTerm<Ts>::ColumnSpan(std::get<Is>(slice.columns), slice.count)...));
+    }
+
+    Iterator PrimaryIterator(std::size_t begin, std::size_t end) const
+    {
+        Iterator it{_primary ? _primary->data() : nullptr,
+                    begin,
+                    end,
+                    _pools,
+                    nullptr,
+                    nullptr,
+                    _masks,
+                    _required,
+                    _excluded,
+                    _since};
         it.SkipInvalid();
         return it;
     }
 
-    Sentinel end() const { return {}; }
+    Iterator ChunkIterator(std::size_t begin, std::size_t end) const
+    {
+        return Iterator{
+            nullptr, 0, 0, _pools, _chunks.data() + begin, _chunks.data() + end, nullptr, {}, {}, _since};
+    }
 };
 
-} // namespace Assisi::ECS
\ No newline at end of file
+} // namespace Assisi::ECS
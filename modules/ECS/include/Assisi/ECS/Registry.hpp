@@ -7,10 +7,26 @@
 /// IsAlive() validates a handle against the current generation so stale
 /// handles (e.g. held by another entity after its target dies) are safely
 /// detected.
-
+///
+/// The registry also keeps a ComponentMask per entity slot.  Pools registered
+/// under a ComponentId are only visited by Destroy() for entities whose mask
+/// has that bit set, so destroying an entity costs one call per component it
+/// actually has rather than one per pool.
+///
+/// Free slots form an implicit list threaded through the slot table: each
+/// free slot stores the index of the next one beside its generation, and the
+/// list head is atomic.  Reserve() pops from it (or claims a fresh index from
+/// an atomic counter) without locking, so worker threads can obtain valid
+/// handles while the main thread is not touching the registry.  Reserved
+/// entities are counted, and fresh slots allocated, by the next Flush();
+/// every other mutating call flushes first.
+
+#include <atomic>
 #include <cstdint>
+#include <span>
 #include <vector>
 
+#include <Assisi/ECS/ComponentId.hpp>
 #include <Assisi/ECS/Entity.hpp>
 #include <Assisi/ECS/SparseSet.hpp>
 
@@ -25,9 +41,35 @@ struct PoolEntry
 
 struct Registry
 {
+    Registry() = default;
+    Registry(const Registry &)            = delete;
+    Registry &operator=(const Registry &) = delete;
+
     /// @brief Allocates a new entity, reusing a free slot if one is available.
     Entity Create();
 
+    /// @brief Hands out a new entity handle.  Safe to call from any number of threads at once.
+    ///
+    /// Must not overlap any other Registry call.  The handle is unique and
+    /// final, but the entity only becomes alive once Flush() runs: until then
+    /// IsAlive() may report either way and it must not be given components.
+    /// Record those into a CommandBuffer instead, whose playback flushes.
+    [[nodiscard]] Entity Reserve();
+
+    /// @brief Makes every entity returned by Reserve() since the last flush alive.
+    void Flush()
+    {
+        if (_freeHead.load(std::memory_order_relaxed) != _flushedHead ||
+            _freshEnd.load(std::memory_order_relaxed) != _slots.size())
+            FlushReserved();
+    }
+
+    /// @brief Allocates out.size() entities, writing their handles into `out`.
+    ///
+    /// Free slots are reused first; the remainder are appended with a single
+    /// resize of the slot tables.
+    void CreateMany(std::span<Entity> out);
+
     /// @brief Releases an entity, invalidating all existing handles to it.
     ///
     /// Increments the generation for the slot so any stored Entity with the
@@ -35,40 +77,158 @@ struct Registry
     /// already dead.
     void Destroy(Entity entity);
 
+    /// @brief Releases every live entity in `entities`.
+    ///
+    /// Equivalent to calling Destroy() on each, but removes components pool by
+    /// pool: each pool is visited once and sweeps all of the batch's entities
+    /// that have that component.  Dead and duplicate handles are skipped.
+    void DestroyMany(std::span<const Entity> entities);
+
     /// @brief Returns true if the entity handle is still valid.
     [[nodiscard]] bool IsAlive(Entity entity) const;
 
     /// @brief Returns the number of currently live entities.
     [[nodiscard]] std::size_t AliveCount() const;
 
+    /// @brief Appends every live entity to `out`, in index order.  Unflushed reservations are left out.
+    void CollectAlive(std::vector<Entity> &out) const;
+
+    /// @brief Returns the number of entity slots: the highest index handed out and flushed, plus one.
+    ///
+    /// Slots not alive are on the free list.
+    [[nodiscard]] std::size_t SlotCount() const { return _slots.size(); }
+
+    /// @brief Bytes held by the slot table and the per-slot masks.
+    [[nodiscard]] std::size_t MemoryBytes() const
+    {
+        return _slots.capacity() * sizeof(Slot) + _masks.capacity() * sizeof(ComponentMask);
+    }
+
+    /// @brief Moves every live entity down to indices [0, AliveCount()), keeping their order.
+    ///
+    /// Writes remap[oldIndex] = the entity's new handle (NullEntity for slots
+    /// that were free) and generations[oldIndex] = the slot's generation
+    /// before the call, empties the free list and shrinks the slot tables to
+    /// the live count.  A moved entity takes the higher of its own generation
+    /// and its destination's, so no handle ever issued for the destination
+    /// slot matches it.  Registered pools are left alone; the caller rewrites
+    /// their entity arrays (Scene::Compact() does both).
+    void Compact(std::vector<Entity> &remap, std::vector<uint32_t> &generations);
+
     /// @brief Registers a component pool so Destroy() removes the entity from it.
     /// The pool must outlive the registry (or be unregistered before destruction).
+    ///
+    /// Pools registered this way are visited for every destroyed entity, since
+    /// the registry cannot see their Add/Remove calls.
     template <typename T> void RegisterPool(SparseSet<T> *pool) { _pools.push_back({pool, &RemoveFn<T>}); }
 
+    /// @brief Registers a type-erased pool holding component `id`.
+    ///
+    /// Destroy() calls remove(pool, entity) only for entities whose mask has
+    /// `id` set, so the owner must report every Add/Remove through
+    /// SetComponent()/ResetComponent().  Ids that do not fit in a ComponentMask
+    /// are visited unconditionally instead.
+    void RegisterPool(ComponentId id, void *pool, void (*remove)(void *pool, Entity entity));
+
+    /// @brief Records that a live entity now has component `id`.
+    void SetComponent(Entity entity, ComponentId id)
+    {
+        if (IsAlive(entity))
+            _masks[entity.index].Set(id);
+    }
+
+    /// @brief Records that a live entity no longer has component `id`.
+    void ResetComponent(Entity entity, ComponentId id)
+    {
+        if (IsAlive(entity))
+            _masks[entity.index].Reset(id);
+    }
+
+    /// @brief Returns the component mask of a live entity, or an empty mask for stale handles.
+    [[nodiscard]] ComponentMask Mask(Entity entity) const
+    {
+        return IsAlive(entity) ? _masks[entity.index] : ComponentMask{};
+    }
+
+    /// @brief Returns true if the live entity has every component set in `required`.
+    [[nodiscard]] bool Matches(Entity entity, const ComponentMask &required) const
+    {
+        return IsAlive(entity) && _masks[entity.index].Contains(required);
+    }
+
+    /// @brief Per-slot masks, indexed by Entity::index.  Entries of dead slots are empty.
+    const std::vector<ComponentMask> &Masks() const { return _masks; }
+
     /// @brief Unregisters a previously registered pool.
     void UnregisterPool(void *pool);
 
     /// @brief Resets all entity counters to zero.
     ///
-    /// Clears the generation table and the free-slot list so the next Create()
-    /// returns Entity{0, 0} again.  Caller is responsible for clearing all
+    /// Clears the slot table and the free list so the next Create() returns
+    /// Entity{0, 0} again.  Caller is responsible for clearing all
     /// component pools before calling this (Scene::Clear() does both).
     void Reset()
     {
-        _generations.clear();
-        _freeSlots.clear();
+        _slots.clear();
+        _masks.clear();
+        _freeHead.store(NoSlot, std::memory_order_relaxed);
+        _flushedHead = NoSlot;
+        _freshEnd.store(0, std::memory_order_relaxed);
         _aliveCount = 0;
     }
 
+    /// @brief Copies other's entity tables (generations, masks, free list) over this registry's.
+    ///
+    /// Registered pools are left alone; the caller copies their contents
+    /// (Scene::CloneInto() does both).  Unflushed reservations are copied as such.
+    void CopyEntities(const Registry &other)
+    {
+        _slots       = other._slots;
+        _masks       = other._masks;
+        _freeHead.store(other._freeHead.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        _flushedHead = other._flushedHead;
+        _freshEnd.store(other._freshEnd.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        _aliveCount  = other._aliveCount;
+    }
+
   private:
+    /// End-of-list marker for the free list.
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+
+    struct Slot
+    {
+        uint32_t generation; ///< Current generation; for a free slot, the one its next occupant gets.
+        uint32_t nextFree;   ///< Next slot of the free list; only meaningful while the slot is free.
+    };
+
     template <typename T> static void RemoveFn(void *pool, Entity entity)
     {
         static_cast<SparseSet<T> *>(pool)->Remove(entity);
     }
 
-    std::vector<uint32_t> _generations; ///< One generation counter per slot.
-    std::vector<uint32_t> _freeSlots;   ///< Slots available for reuse.
-    std::vector<PoolEntry> _pools;      ///< Registered component pools.
+    /// @brief Counts the reserved entities alive and appends the fresh slots they claimed.
+    void FlushReserved();
+
+    /// @brief Marks every slot on the flushed free list.
+    std::vector<bool> FreeSlots() const;
+
+    /// @brief Pushes a destroyed slot onto the free list.  The registry must be flushed.
+    void Release(uint32_t index)
+    {
+        _slots[index].nextFree = _flushedHead;
+        _flushedHead           = index;
+        _freeHead.store(index, std::memory_order_relaxed);
+    }
+
+    std::vector<Slot> _slots;                 ///< One per entity index.
+    std::vector<ComponentMask> _masks;        ///< One component mask per slot.
+    std::atomic<uint32_t> _freeHead{NoSlot};  ///< First free slot; Reserve() pops from here.
+    uint32_t _flushedHead = NoSlot;           ///< _freeHead as of the last flush.
+    std::atomic<uint32_t> _freshEnd{0};       ///< One past the last index handed out; ahead of _slots until a flush.
+    std::vector<PoolEntry> _pools;            ///< Pools visited for every destroyed entity.
+    std::vector<PoolEntry> _componentPools;   ///< Indexed by ComponentId; visited only when the mask bit is set.
+
+    std::vector<Entity> _dying; ///< Scratch for DestroyMany(), kept to avoid reallocating per batch.
 
     std::size_t _aliveCount = 0;
 };
@@ -6,34 +6,298 @@
 /// Scene lazily creates a SparseSet<T> on the first Add<T> call and registers
 /// it with the internal Registry so Destroy(entity) automatically removes the
 /// entity from every pool it belongs to.
+///
+/// A scene constructed with StorageMode::Archetype keeps its components in
+/// archetype chunks instead (see Archetype.hpp).  Create/Destroy/Add/Remove/Get/
+/// Has/Query/Clear behave identically in both modes; archetype storage trades
+/// slower Add/Remove (the entity's row moves between archetypes) for linear,
+/// lookup-free query iteration.
+///
+/// Pools are found by indexing a vector with the component's dense
+/// ComponentId, so Get/Has/Add/Remove never hash a type.
+///
+/// Components with a SoaLayout (see SoaLayout.hpp) are stored field-by-field;
+/// Get/Add/Query hand them out as SoaRef<T>, and Columns<T>() exposes their
+/// field arrays.  They are sparse-set only.
+///
+/// Component pools allocate from the scene's std::pmr::memory_resource: the
+/// global heap by default, a private arena for SceneMemory::Arena, or any
+/// resource passed in.  Each pool can be capped with SetPoolBudget<T>(), and
+/// PoolMemory() reports what every pool holds; Stats() adds occupancy (size
+/// against capacity, live sparse slots) and the entity table.  Entity tables
+/// and archetype chunks always use the global heap.
+///
+/// CloneInto()/Snapshot()/Restore() copy a whole scene, handles included, by
+/// copying the entity tables and pool arrays directly.
+///
+/// Entity tables and sparse pages only grow, so after heavy churn they stay
+/// sized for the historical peak.  Compact() renumbers the live entities to
+/// the lowest indices and gives the slack back; run it where handle churn is
+/// expected anyway (level transitions, idle frames).
+///
+/// Per-scene singletons (the active camera, lighting settings, frame counters)
+/// are resources rather than components on a dummy entity: SetResource<T>()
+/// stores one T per scene in a slot array indexed by ResourceIdOf<T>(), so
+/// Resource<T>() is a bounds check and a pointer load.  Resources are copied
+/// by CloneInto() and survive Clear().
+///
+/// Systems that run the same query every frame can keep a CachedQuery from
+/// MakeQuery<Ts...>(): it resolves its pools once and only again when
+/// PoolEpoch() moves.
+///
+/// OnAdded<T>()/OnRemoved<T>()/OnUpdated<T>() connect listeners to T's
+/// component events, which Collector (see Collector.hpp) builds on to hand a
+/// system only the entities that changed since its last run.  Signals live in
+/// a slot array indexed by ComponentId, so a component nobody listens to costs
+/// one bounds check per Add/Remove/MarkChanged.  Clear() and CloneInto()
+/// replace the world wholesale and report nothing.
+///
+/// Composite objects spawned many times over are better built from a Prefab
+/// (see Prefab.hpp), which copies a template entity set pool by pool in one
+/// AddMany() per component type instead of one Add() per component.
 
+#include <array>
+#include <cstring>
 #include <expected>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
 #include <typeindex>
-#include <unordered_map>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
+#include <Assisi/ECS/Archetype.hpp>
+#include <Assisi/ECS/ComponentId.hpp>
+#include <Assisi/ECS/Group.hpp>
 #include <Assisi/ECS/Query.hpp>
 #include <Assisi/ECS/Registry.hpp>
 
 namespace Assisi::ECS
 {
 
+/// @brief Component storage backend used by a Scene.  Fixed at construction.
+enum class StorageMode
+{
+    SparseSet, ///< One SparseSet<T> per component type.  Cheapest Add/Remove.
+    Archetype, ///< Entities grouped by signature into SoA chunks.  Fastest multi-component queries.
+};
+
+/// @brief Where a Scene's component pools allocate from.  Fixed at construction.
+enum class SceneMemory
+{
+    Heap,  ///< The global heap, via std::pmr::get_default_resource().
+    Arena, ///< A monotonic arena owned by the scene.  Nothing is returned until the scene dies.
+};
+
+/// @brief Memory held by one component pool, as reported by Scene::PoolMemory().
+struct PoolMemoryUsage
+{
+    ComponentId id;
+    const std::type_info *type;
+    std::size_t bytes;  ///< Sparse pages plus dense capacity.
+    std::size_t budget; ///< 0 = unlimited.
+};
+
+/// @brief Occupancy of one component pool, as reported by Scene::Stats().
+struct PoolStats
+{
+    ComponentId id;
+    const std::type_info *type;
+    std::size_t size;        ///< Components stored.
+    std::size_t capacity;    ///< Components the dense arrays hold before they grow.
+    std::size_t denseBytes;  ///< Capacity of the component, entity and tick arrays.
+    std::size_t sparseBytes; ///< Sparse page table plus allocated pages.
+    std::size_t sparseSlots; ///< Entity indices the allocated sparse pages cover.
+    std::size_t budget;      ///< 0 = unlimited.
+
+    /// @brief Fraction of the allocated sparse slots in use.  Low means pages held for a few scattered entities.
+    double SparseOccupancy() const
+    {
+        return sparseSlots == 0 ? 0.0 : static_cast<double>(size) / static_cast<double>(sparseSlots);
+    }
+};
+
+/// @brief Occupancy of one archetype, as reported by Scene::Stats().
+struct ArchetypeStats
+{
+    std::size_t components; ///< Component types in the signature.
+    std::size_t size;       ///< Entities stored.
+    std::size_t capacity;   ///< Rows the allocated chunks hold.
+    std::size_t bytes;      ///< Allocated chunk memory.
+};
+
+/// @brief A scene's entity table and storage at one point in time, as returned by Scene::Stats().
+struct SceneStats
+{
+    std::size_t alive;                      ///< Live entities.
+    std::size_t slots;                      ///< Entity slots: the highest index handed out, plus one.
+    std::size_t freeSlots;                  ///< Slots waiting on the free list.
+    std::vector<PoolStats> pools;           ///< In ComponentId order; sparse-set scenes only.
+    std::vector<ArchetypeStats> archetypes; ///< In creation order; archetype scenes only.
+};
+
+/// @brief What Scene::Compact() did, and how to translate handles taken before it.
+struct CompactReport
+{
+    std::size_t slotsBefore;           ///< Entity slots before: the highest index ever handed out, plus one.
+    std::size_t slotsAfter;            ///< Entity slots after: the live entity count.
+    std::size_t bytesBefore;           ///< Entity tables plus component storage, before.
+    std::size_t bytesAfter;            ///< Entity tables plus component storage, after.
+    std::vector<Entity> remap;         ///< Old Entity::index -> new handle; NullEntity for slots that were free.
+    std::vector<uint32_t> generations; ///< Old Entity::index -> its generation before Compact().
+
+    /// @brief The new handle of an entity that was alive before Compact(), or NullEntity.
+    ///
+    /// The new handle may carry a higher generation than the old one.
+    Entity Remap(Entity entity) const
+    {
+        const Entity moved = entity.index < remap.size() ? remap[entity.index] : NullEntity;
+        return moved != NullEntity && generations[entity.index] == entity.generation ? moved : NullEntity;
+    }
+};
+
+enum class SnapshotError
+{
+    ModeMismatch, ///< Returned by Scene::CloneInto() if the target scene uses a different StorageMode.
+    NotCopyable,  ///< A stored component or resource type is not copyable.  Nothing was changed.
+};
+
+/// @brief Component events a Scene reports to listeners (see Scene::OnAdded()).
+enum class ComponentEvent : uint8_t
+{
+    Added,   ///< After the component was added.
+    Removed, ///< Before the component is removed, on its own or with its entity.
+    Updated, ///< After Patch() or MarkChanged() on the component.
+};
+
+struct Scene;
+
+/// @brief Called with the scene and the entity whose component raised the event.
+using ComponentListener = std::function<void(Scene &scene, Entity entity)>;
+
+/// @brief A connected listener, as returned by Scene::OnAdded() and friends.  Pass to Scene::Disconnect().
+struct SignalConnection
+{
+    ComponentId component = 0;
+    ComponentEvent event  = ComponentEvent::Added;
+    uint32_t id           = 0; ///< 0 = not connected.
+};
+
+template <typename... Ts> class CachedQuery;
+class Prefab;
+
 struct Scene
 {
+    Scene() = default;
+
+    /// @brief Creates a scene; SceneMemory::Arena suits small scenes that are built once and torn down whole.
+    explicit Scene(StorageMode mode, SceneMemory memory = SceneMemory::Heap) : _mode(mode)
+    {
+        if (memory == SceneMemory::Arena)
+        {
+            _arena    = std::make_unique<std::pmr::monotonic_buffer_resource>();
+            _resource = _arena.get();
+        }
+    }
+
+    /// @brief Creates a scene whose pools allocate from `resource`, which must outlive it.
+    Scene(StorageMode mode, std::pmr::memory_resource *resource) : _mode(mode), _resource(resource) {}
+
     ~Scene()
     {
-        for (auto &[type, storage] : _pools)
-            storage.destroy(storage.pool);
+        for (auto &storage : _pools)
+        {
+            if (storage)
+                storage->destroy(storage->pool, _resource);
+        }
+        for (ResourceSlot &slot : _resources)
+        {
+            if (slot.value)
+                slot.destroy(slot.value, _resource);
+        }
     }
 
+    /// @brief Returns the storage backend this scene was created with.
+    StorageMode Mode() const { return _mode; }
+
+    /// @brief Returns the memory resource component pools and resources allocate from.
+    std::pmr::memory_resource *MemoryResource() const { return _resource; }
+
+    /// @brief Tick stamped on components added or marked changed right now.
+    Tick CurrentTick() const { return _tick; }
+
+    /// @brief Starts a new tick.  SystemRegistry calls this after every system it runs.
+    void AdvanceTick() { ++_tick; }
+
     /// @brief Allocates a new entity.
     Entity Create() { return _registry.Create(); }
 
     /// @brief Releases an entity, removing it from all registered pools.
-    void Destroy(Entity entity) { _registry.Destroy(entity); }
+    void Destroy(Entity entity)
+    {
+        if (_removalListeners != 0)
+            NotifyDestroy(entity);
+        if (_mode == StorageMode::Archetype && _registry.IsAlive(entity))
+            _archetypes.RemoveEntity(entity);
+        _registry.Destroy(entity);
+    }
+
+    /// @brief Allocates out.size() entities in one batch, writing their handles into `out`.
+    void CreateMany(std::span<Entity> out) { _registry.CreateMany(out); }
+
+    /// @brief Hands out an entity handle from any thread, e.g. inside ParallelEach (see Registry::Reserve()).
+    ///
+    /// The entity becomes alive at the next FlushReserved(), which command
+    /// buffer playback runs first, so record its components there:
+    /// @code
+    ///   const Entity debris = scene.Reserve();
+    ///   ctx.Commands().Add<Transform>(debris, transform);
+    /// @endcode
+    [[nodiscard]] Entity Reserve() { return _registry.Reserve(); }
+
+    /// @brief Makes every entity handed out by Reserve() alive.  Main thread, no Reserve() running.
+    ///
+    /// Create/Destroy and their batch forms flush on their own.
+    void FlushReserved() { _registry.Flush(); }
+
+    /// @brief Releases every live entity in `entities`, removing each pool's share in one sweep.
+    ///
+    /// Dead and duplicate handles are skipped.
+    void DestroyMany(std::span<const Entity> entities)
+    {
+        if (_removalListeners != 0)
+            NotifyDestroyMany(entities);
+        if (_mode == StorageMode::Archetype)
+        {
+            for (Entity entity : entities)
+            {
+                if (_registry.IsAlive(entity))
+                    _archetypes.RemoveEntity(entity);
+            }
+        }
+        _registry.DestroyMany(entities);
+    }
 
     /// @brief Returns true if the entity handle is still valid.
     bool IsAlive(Entity entity) const { return _registry.IsAlive(entity); }
 
+    /// @brief Moves every live entity down to indices [0, AliveCount()) and frees the memory that leaves unused.
+    ///
+    /// Entities keep their relative order, components and dense positions (a
+    /// moved entity may get a higher generation, so stale handles to its new
+    /// slot stay stale); the entity tables, sparse pages, dense arrays and (archetype
+    /// scenes) spare chunks are shrunk to fit.  Reflected EntityRef fields of
+    /// components and resources are rewritten, and those pointing at dead
+    /// entities become NullEntity.  Reports no component events.
+    ///
+    /// Every other handle taken before the call is invalid after it: translate
+    /// the ones you keep (system members, selection) with the report's Remap(),
+    /// and Clear() any Collector.  Not while a view or Reserve() is live.
+    CompactReport Compact();
+
     /// @brief Returns the number of currently live entities.
     std::size_t AliveCount() const { return _registry.AliveCount(); }
 
@@ -41,101 +305,540 @@ struct Scene
     ///
     /// After this call the scene is equivalent to a freshly constructed one:
     /// the next Create() returns Entity{0, 0}.  All component pools are kept
-    /// alive (no allocations freed) so they can be refilled without realloc.
+    /// alive (no allocations freed, sparse pages included) so they can be
+    /// refilled without realloc.
+    /// Resources are not entities and are kept as well.
     void Clear()
     {
-        for (auto &[type, storage] : _pools)
-            storage.clear(storage.pool);
+        for (auto &storage : _pools)
+        {
+            if (storage)
+                storage->clear(storage->pool);
+        }
+        for (auto &group : _groups)
+            group->size = 0;
+        _archetypes.Clear();
         _registry.Reset();
     }
 
     /// @brief Adds a component of type T to the entity.
     ///
     /// Creates the component pool on first use.
-    /// @return Pointer to the new component on success, or
-    ///         SparseSetError::AlreadyExists if the entity already has one.
-    template <typename T> [[nodiscard]] std::expected<T *, SparseSetError> Add(Entity entity, T component = {})
+    /// @return Pointer to the new component (SoaRef<T> for SoA components) on
+    ///         success, SparseSetError::AlreadyExists if the entity already has
+    ///         one, SparseSetError::BudgetExceeded if T's pool is full (see
+    ///         SetPoolBudget()), SparseSetError::SoaInArchetypeScene, or
+    ///         SparseSetError::NotAlive for a stale handle.
+    template <typename T>
+    [[nodiscard]] std::expected<ComponentRef<T>, SparseSetError> Add(Entity entity, T component = {})
     {
-        return GetOrCreatePool<T>().Add(entity, component);
+        /* Pools are indexed by entity index alone: a stale handle would hit the entity reusing its slot. */
+        if (!IsAlive(entity))
+            return std::unexpected(SparseSetError::NotAlive);
+
+        if (_mode == StorageMode::Archetype)
+        {
+            if constexpr (SoaComponent<T>)
+                return std::unexpected(SparseSetError::SoaInArchetypeScene);
+            else
+            {
+                auto result = _archetypes.Add(entity, component);
+                if (!result)
+                    return result;
+
+                _registry.SetComponent(entity, ComponentIdOf<T>());
+                ComponentSignals *signals = FindSignals(ComponentIdOf<T>());
+                if (!signals)
+                    return result;
+
+                /* Listeners may add other components, moving the entity's row. */
+                Emit(*signals, ComponentEvent::Added, entity);
+                return _archetypes.Get<T>(entity);
+            }
+        }
+
+        PoolStorage &storage = GetOrCreateStorage<T>();
+        auto *pool = static_cast<SparseSet<T> *>(storage.pool);
+        auto result = pool->Add(entity, component, _tick);
+        if (!result)
+            return result;
+
+        _registry.SetComponent(entity, ComponentIdOf<T>());
+        ComponentSignals *signals = FindSignals(ComponentIdOf<T>());
+        if (!storage.group && !signals)
+            return result;
+
+        /* Entering a group may swap the new component into the packed prefix. */
+        EnterGroup(storage, entity);
+        if (signals)
+            Emit(*signals, ComponentEvent::Added, entity);
+        return pool->Get(entity);
+    }
+
+    /// @brief Adds components[i] to entities[i] for every i.
+    ///
+    /// Reserves the pool's dense capacity once for the whole batch.  Entities
+    /// that already have a T are skipped, as are stale handles and everything
+    /// past T's pool budget.
+    /// @return The number of components added, or SparseSetError::SizeMismatch
+    ///         if the spans differ in length.
+    template <typename T>
+    [[nodiscard]] std::expected<std::size_t, SparseSetError> AddMany(std::span<const Entity> entities,
+                                                                     std::span<const T> components)
+    {
+        if (entities.size() != components.size())
+            return std::unexpected(SparseSetError::SizeMismatch);
+
+        std::size_t added = 0;
+        if (_mode == StorageMode::Archetype)
+        {
+            for (std::size_t i = 0; i < entities.size(); ++i)
+            {
+                if (Add<T>(entities[i], components[i]))
+                    ++added;
+            }
+            return added;
+        }
+
+        PoolStorage &storage = GetOrCreateStorage<T>();
+        auto *pool = static_cast<SparseSet<T> *>(storage.pool);
+        pool->Reserve(pool->Size() + entities.size());
+
+        const ComponentId id = ComponentIdOf<T>();
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            if (!IsAlive(entities[i]) || !pool->Add(entities[i], components[i], _tick))
+                continue;
+
+            _registry.SetComponent(entities[i], id);
+            if (storage.group)
+                EnterGroup(storage, entities[i]);
+            Notify(id, ComponentEvent::Added, entities[i]);
+            ++added;
+        }
+        return added;
     }
 
     /// @brief Returns a pointer to the entity's component of type T, or nullptr if not present.
-    template <typename T> T *Get(Entity entity)
+    ///
+    /// SoA components come back as a SoaRef<T>, empty if not present.
+    template <typename T> ComponentRef<T> Get(Entity entity)
     {
-        auto it = _pools.find(typeid(T));
-        if (it == _pools.end())
-            return nullptr;
-        return static_cast<SparseSet<T> *>(it->second.pool)->Get(entity);
+        if (_mode == StorageMode::Archetype)
+        {
+            if constexpr (SoaComponent<T>)
+                return {};
+            else
+                return _archetypes.Get<T>(entity);
+        }
+
+        SparseSet<T> *pool = GetPool<T>();
+        return pool ? pool->Get(entity) : ComponentRef<T>{};
     }
 
     /// @brief Returns a const pointer to the entity's component of type T, or nullptr if not present.
-    template <typename T> const T *Get(Entity entity) const
+    template <typename T> ComponentRef<const T> Get(Entity entity) const
     {
-        auto it = _pools.find(typeid(T));
-        if (it == _pools.end())
-            return nullptr;
-        return static_cast<const SparseSet<T> *>(it->second.pool)->Get(entity);
+        if (_mode == StorageMode::Archetype)
+        {
+            if constexpr (SoaComponent<T>)
+                return {};
+            else
+                return _archetypes.Get<T>(entity);
+        }
+
+        const SparseSet<T> *pool = GetPool<T>();
+        return pool ? pool->Get(entity) : ComponentRef<const T>{};
     }
 
     /// @brief Returns true if the entity has a component of type T.
     template <typename T> bool Has(Entity entity) const
     {
-        auto it = _pools.find(typeid(T));
-        return it != _pools.end() && static_cast<const SparseSet<T> *>(it->second.pool)->Has(entity);
+        if (_mode == StorageMode::Archetype)
+            return _archetypes.Has<T>(entity);
+
+        const SparseSet<T> *pool = GetPool<T>();
+        return pool && pool->Has(entity);
     }
 
-    /// @brief Removes the component of type T from the entity.
+    /// @brief Stamps the entity's T as changed at the current tick, for Changed<T> queries.
+    ///
+    /// Mutable access alone never counts as a change (every query hands out
+    /// references), so writers that want to be observed call this or Patch().
+    template <typename T> void MarkChanged(Entity entity)
+    {
+        if (SparseSet<T> *pool = _mode == StorageMode::SparseSet ? GetPool<T>() : nullptr)
+            pool->MarkChanged(entity, _tick);
+
+        ComponentSignals *signals = FindSignals(ComponentIdOf<T>());
+        if (signals && IsAlive(entity) && Has<T>(entity))
+            Emit(*signals, ComponentEvent::Updated, entity);
+    }
+
+    /// @brief Calls fn(T&) (fn(SoaRef<T>) for SoA components) on the entity's component and marks it changed.
+    /// @return false if the entity has no T.
+    template <typename T, typename Fn> bool Patch(Entity entity, Fn &&fn)
+    {
+        ComponentRef<T> component = Get<T>(entity);
+        if (!component)
+            return false;
+
+        if constexpr (SoaComponent<T>)
+            fn(component);
+        else
+            fn(*component);
+        MarkChanged<T>(entity);
+        return true;
+    }
+
+    /// @brief Returns true if the entity is alive and has every component in Ts.
+    ///
+    /// A single mask comparison unless one of Ts has an id beyond ComponentMask::MaxComponents.
+    template <typename... Ts> bool Matches(Entity entity) const
+    {
+        if ((... && ComponentMask::Fits(ComponentIdOf<Ts>())))
+            return _registry.Matches(entity, ComponentMask::Of<Ts...>());
+        return IsAlive(entity) && (... && Has<Ts>(entity));
+    }
+
+    /// @brief Returns the set of component ids the entity has (empty for stale handles).
+    ComponentMask Mask(Entity entity) const { return _registry.Mask(entity); }
+
+    /// @brief Removes the component of type T from the entity.  Does nothing for stale handles.
     template <typename T> void Remove(Entity entity)
     {
-        auto it = _pools.find(typeid(T));
-        if (it != _pools.end())
-            static_cast<SparseSet<T> *>(it->second.pool)->Remove(entity);
+        if (!IsAlive(entity))
+            return;
+
+        ComponentSignals *signals = FindSignals(ComponentIdOf<T>());
+        if (signals && Has<T>(entity))
+            Emit(*signals, ComponentEvent::Removed, entity);
+
+        _registry.ResetComponent(entity, ComponentIdOf<T>());
+        if (_mode == StorageMode::Archetype)
+        {
+            _archetypes.Remove<T>(entity);
+            return;
+        }
+
+        if (PoolStorage *storage = FindStorage(ComponentIdOf<T>()))
+            RemoveFromPool(storage, entity);
     }
 
     /// @brief Returns a lazy view over all entities that have every component in Ts.
     ///
-    /// Iterates the smallest matching pool and skips entities absent from the others.
+    /// Iterates the smallest matching pool and skips entities absent from the others
+    /// (archetype storage: walks every matching chunk in order).
     /// Supports structured bindings: `for (auto [e, pos, vel] : scene.Query<Position, Velocity>())`
-    template <typename... Ts> QueryView<Ts...> Query()
+    ///
+    /// Ts may include Optional<T>, Exclude<Us...> and Changed<T> / Added<T>
+    /// terms (see Query.hpp).  Changed/Added compare against `since`, typically
+    /// SystemContext::lastRunTick; archetype scenes do not track ticks, so there
+    /// those two always pass.
+    template <typename... Ts> QueryView<Ts...> Query(Tick since = 0)
+    {
+        if (_mode == StorageMode::Archetype)
+            return QueryView<Ts...>::FromArchetypes(_archetypes, since);
+
+        return QueryView<Ts...>::FromPools(
+            [this]<typename T>(std::type_identity<T>) { return GetPool<T>(); }, &_registry.Masks(), since);
+    }
+
+    /// @brief Returns a persistent Query<Ts...>() to keep across frames (see CachedQuery).
+    ///
+    /// The scene must outlive the returned object.
+    template <typename... Ts> CachedQuery<Ts...> MakeQuery() { return CachedQuery<Ts...>(*this); }
+
+    /// @brief Changes whenever a component pool (in archetype scenes: an archetype) is created.
+    ///
+    /// Views resolved while it keeps its value still point at every pool they need.
+    std::size_t PoolEpoch() const
+    {
+        return _mode == StorageMode::Archetype ? _archetypes.Archetypes().size() : _poolEpoch;
+    }
+
+    /// @brief Query<Ts...>() that also skips entities having any of Us.
+    ///
+    /// Same as `Query<Ts..., Exclude<Us...>>(since)`:
+    /// `for (auto [e, transform] : scene.Query<Transform>(Exclude<Parent>{}))`
+    template <typename... Ts, typename... Us> QueryView<Ts..., Exclude<Us...>> Query(Exclude<Us...>, Tick since = 0)
+    {
+        return Query<Ts..., Exclude<Us...>>(since);
+    }
+
+    /// @brief Returns the field arrays of T's pool for SIMD kernels (see SoaLayout.hpp).
+    ///
+    /// Empty if no T has been added yet, and always empty in archetype scenes.
+    /// The spans are invalidated by any structural change to the pool.
+    template <typename T>
+        requires SoaComponent<T>
+    SoaColumns<T> Columns()
+    {
+        return SoaColumns<T>{GetPool<T>()};
+    }
+
+    /// @brief Sorts T's pool so `compare` (over `const T &` or Entity) holds in iteration order.
+    ///
+    /// If a group owns the pool, the group's packed prefix is sorted with every
+    /// owned pool following along, so the group stays aligned, and the rest of
+    /// T's pool is sorted on its own.  Already sorted pools cost one linear
+    /// check.  Does nothing in archetype scenes, whose order is chunk order.
+    /// Invalidates component pointers and views, like Remove().
+    template <typename T, typename Compare> void SortPool(Compare compare)
     {
-        std::tuple<SparseSet<Ts> *...> pools = {GetPool<Ts>()...};
+        SparseSet<T> *pool = _mode == StorageMode::SparseSet ? GetPool<T>() : nullptr;
+        if (!pool)
+            return;
 
-        /* If any pool is missing, there are no matching entities. */
-        bool anyNull = false;
-        std::apply([&](auto *...ps) { anyNull = (... || (ps == nullptr)); }, pools);
-        if (anyNull)
+        const auto swap = [pool](uint32_t a, uint32_t b) { pool->SwapDense(a, b); };
+        const GroupData *group = FindStorage(ComponentIdOf<T>())->group;
+        if (!group)
         {
-            return QueryView<Ts...>{pools, nullptr};
+            pool->Sort(0, static_cast<uint32_t>(pool->Size()), compare, swap);
+            return;
         }
 
-        /* Drive iteration from the smallest pool to minimise skipped entities. */
-        const std::vector<Entity> *primary = nullptr;
-        std::size_t minSize = SIZE_MAX;
-        std::apply(
-            [&](auto *...ps)
-            {
-                auto check = [&](auto *p)
-                {
-                    if (p->Size() < minSize)
-                    {
-                        minSize = p->Size();
-                        primary = &p->Entities();
-                    }
-                };
-                (check(ps), ...);
-            },
-            pools);
+        pool->Sort(0, group->size, compare, [group](uint32_t a, uint32_t b) { SwapInGroup(*group, a, b); });
+        pool->Sort(group->size, static_cast<uint32_t>(pool->Size()), compare, swap);
+    }
+
+    /// @brief Reorders T's pool so the entities it shares with U's pool come first, in U's order.
+    ///
+    /// Useful for making two pools iterate in lockstep.  Group-owned pools
+    /// keep their packed prefix: shared entities inside it are ordered within
+    /// it (moving the other owned pools along), the rest after it.  Does
+    /// nothing in archetype scenes or if either pool does not exist.
+    template <typename T, typename U> void SortLike()
+    {
+        SparseSet<T> *pool = _mode == StorageMode::SparseSet ? GetPool<T>() : nullptr;
+        const SparseSet<U> *like = pool ? GetPool<U>() : nullptr;
+        if (!like || static_cast<const void *>(pool) == static_cast<const void *>(like))
+            return;
+
+        const GroupData *group = FindStorage(ComponentIdOf<T>())->group;
+        const uint32_t packed = group ? group->size : 0;
+        uint32_t front = 0;
+        uint32_t back = packed;
+        for (Entity entity : like->Entities())
+        {
+            const uint32_t pos = pool->IndexOf(entity);
+            if (pos == SparseSet<T>::Invalid)
+                continue;
 
-        return QueryView<Ts...>{pools, primary};
+            if (pos < packed)
+                SwapInGroup(*group, front++, pos);
+            else
+                pool->SwapDense(back++, pos);
+        }
+    }
+
+    /// @brief Calls `listener` after a T is added to an entity: Add(), AddMany(), command buffer playback.
+    ///
+    /// Listeners run synchronously, in connection order, on the thread that
+    /// made the change.  They may read the scene and add or remove other
+    /// components, but must not remove the T that raised the event, destroy the
+    /// entity, or connect and disconnect listeners; record those into a
+    /// CommandBuffer instead.
+    template <typename T> SignalConnection OnAdded(ComponentListener listener)
+    {
+        return Connect<T>(ComponentEvent::Added, std::move(listener));
+    }
+
+    /// @brief Calls `listener` before an entity's T is removed, by Remove() or with the entity by Destroy().
+    ///
+    /// The component is still readable from the listener.
+    template <typename T> SignalConnection OnRemoved(ComponentListener listener)
+    {
+        return Connect<T>(ComponentEvent::Removed, std::move(listener));
+    }
+
+    /// @brief Calls `listener` after Patch() or MarkChanged() on an entity's T.
+    ///
+    /// Runs on the writer's thread: if T is marked changed from inside
+    /// ParallelEach, the listener must be thread-safe.
+    template <typename T> SignalConnection OnUpdated(ComponentListener listener)
+    {
+        return Connect<T>(ComponentEvent::Updated, std::move(listener));
+    }
+
+    /// @brief Disconnects a listener.  Does nothing for connections already disconnected.
+    void Disconnect(SignalConnection connection);
+
+    /// @brief Stores the scene's T resource, constructed from `args`, replacing any previous one.
+    ///
+    /// Replacing destroys the old value, so pointers to it dangle.
+    /// @return The stored resource.
+    template <typename T, typename... Args> T &SetResource(Args &&...args)
+    {
+        const ResourceId id = ResourceIdOf<T>();
+        if (id >= _resources.size())
+            _resources.resize(id + 1);
+
+        T *value = std::pmr::polymorphic_allocator<>(_resource).new_object<T>(std::forward<Args>(args)...);
+        ResourceSlot &slot = _resources[id];
+        if (slot.value)
+            slot.destroy(slot.value, _resource);
+        slot = {value, &DestroyResourceFn<T>, CopyResourceOf<T>()};
+        return *value;
+    }
+
+    /// @brief Returns the scene's T resource, or nullptr if none is set.
+    template <typename T> T *Resource() { return static_cast<T *>(FindResource(ResourceIdOf<T>())); }
+
+    /// @copydoc Resource()
+    template <typename T> const T *Resource() const
+    {
+        return static_cast<const T *>(FindResource(ResourceIdOf<T>()));
+    }
+
+    /// @brief Returns true if the scene holds a T resource.
+    template <typename T> bool HasResource() const { return FindResource(ResourceIdOf<T>()) != nullptr; }
+
+    /// @brief Destroys the scene's T resource, if any.
+    template <typename T> void RemoveResource()
+    {
+        const ResourceId id = ResourceIdOf<T>();
+        if (id < _resources.size() && _resources[id].value)
+        {
+            _resources[id].destroy(_resources[id].value, _resource);
+            _resources[id] = {};
+        }
+    }
+
+    /// @brief Caps the bytes T's pool may hold; past it Add<T> fails with SparseSetError::BudgetExceeded.
+    ///
+    /// 0 removes the cap.  Budgets only apply to sparse-set scenes.
+    template <typename T> void SetPoolBudget(std::size_t bytes)
+    {
+        if (_mode == StorageMode::SparseSet)
+            GetOrCreatePool<T>().SetBudget(bytes);
+    }
+
+    /// @brief Returns the memory held by every component pool, in ComponentId order.
+    std::vector<PoolMemoryUsage> PoolMemory() const;
+
+    /// @brief Returns the occupancy of the entity table and of every pool (or archetype).
+    ///
+    /// Walks every pool once; meant for debug views and periodic dumps rather than every frame.
+    SceneStats Stats() const;
+
+    /// @brief Makes `target` a copy of this scene: same entity handles and components.
+    ///
+    /// Copies the entity tables and every pool's sparse, dense and entity
+    /// arrays into target's own pools, reusing the memory they already hold;
+    /// those pools keep their budgets (see SetPoolBudget()).
+    /// Trivially copyable components are copied in bulk, others through their
+    /// copy constructor.  Resources are copy-assigned, and target's resources
+    /// that this scene lacks are removed.  Target's groups are repacked afterwards.  Orders of
+    /// magnitude faster than a SceneSerializer round trip; meant for rollback
+    /// and play-in-editor.
+    ///
+    /// Ticks never run backwards: target's tick becomes one past the later of
+    /// the two scenes' ticks, so systems' lastRun ticks stay valid across a
+    /// Restore().  Every copied component counts as changed at that tick
+    /// (Changed<T> queries see the rolled-back values); added ticks are copied.
+    /// @return SnapshotError::ModeMismatch if the storage modes differ, or
+    ///         SnapshotError::NotCopyable if a component or resource type cannot
+    ///         be copied; target is left untouched on either error.
+    [[nodiscard]] std::expected<void, SnapshotError> CloneInto(Scene &target) const;
+
+    /// @brief Returns a heap-allocated copy of this scene (see CloneInto()).
+    [[nodiscard]] std::expected<std::unique_ptr<Scene>, SnapshotError> Snapshot() const;
+
+    /// @brief Rolls this scene back to `snapshot`.
+    ///
+    /// Component values roll back but the tick moves forward, and every
+    /// component is marked changed (see CloneInto()).  For repeated rollback
+    /// keep one snapshot scene and refresh it with CloneInto(); neither
+    /// direction allocates once the pools have grown.
+    [[nodiscard]] std::expected<void, SnapshotError> Restore(const Scene &snapshot)
+    {
+        return snapshot.CloneInto(*this);
+    }
+
+    /// @brief Returns an owning group over Owned..., creating it on first use.
+    ///
+    /// Creating the group takes ownership of every Owned pool and packs the
+    /// entities that already have all of them; afterwards Add/Remove/Destroy
+    /// keep the packed prefix up to date.  Asking again for the same set of
+    /// types returns a view of the existing group.  The view is invalidated by
+    /// any structural change to an owned pool.
+    /// @return The group view, GroupError::PoolAlreadyOwned if a pool belongs
+    ///         to a different group, or GroupError::ArchetypeStorage in archetype scenes.
+    template <typename... Owned> [[nodiscard]] std::expected<GroupView<Owned...>, GroupError> Group()
+    {
+        static_assert(sizeof...(Owned) >= 2, "An owning group needs at least two component types");
+        static_assert(!(... || SoaComponent<Owned>), "SoA components cannot be owned by a group");
+
+        if (_mode == StorageMode::Archetype)
+            return std::unexpected(GroupError::ArchetypeStorage);
+
+        const std::array<PoolStorage *, sizeof...(Owned)> storages = {&GetOrCreateStorage<Owned>()...};
+
+        GroupData *group = storages.front()->group;
+        for (const PoolStorage *storage : storages)
+        {
+            if (storage->group != group)
+                return std::unexpected(GroupError::PoolAlreadyOwned);
+        }
+        if (group && group->pools.size() != storages.size())
+            return std::unexpected(GroupError::PoolAlreadyOwned);
+
+        if (!group)
+            group = &CreateGroup({storages.begin(), storages.end()});
+
+        const std::tuple<SparseSet<Owned> *...> pools{&GetOrCreatePool<Owned>()...};
+        return GroupView<Owned...>{pools, std::get<0>(pools)->Entities().data(), group->size};
     }
 
   private:
+    template <typename... Ts> friend class CachedQuery;
+    friend class Prefab;
+
+    struct GroupData;
+
+    /// Where the entities of a Prefab copy go: source ordinal -> one target per copy.
+    struct PrefabMapping
+    {
+        std::span<const Entity> sources;   ///< Copied entities, by ordinal.
+        std::span<const uint32_t> ordinals; ///< Source Entity::index -> ordinal, or UINT32_MAX.
+        std::span<const Entity> targets;   ///< copies * sources.size() entities, copy-major.
+        std::size_t copies;
+        bool detach = false; ///< Remap handles to anything but the sources to NullEntity instead of keeping them.
+
+        /// @brief Copy `copy` of a source entity; any other handle is kept, or nulled if `detach` is set.
+        Entity Remap(Entity entity, std::size_t copy) const
+        {
+            const uint32_t ordinal = entity.index < ordinals.size() ? ordinals[entity.index] : UINT32_MAX;
+            if (ordinal == UINT32_MAX || sources[ordinal] != entity)
+                return detach ? NullEntity : entity;
+            return targets[copy * sources.size() + ordinal];
+        }
+    };
+
     struct PoolStorage
     {
         void *pool;
         void (*remove)(void *pool, Entity entity);
         void (*clear)(void *pool);
-        void (*destroy)(void *pool);
+        void (*destroy)(void *pool, std::pmr::memory_resource *resource);
+        bool (*has)(const void *pool, Entity entity);
+        uint32_t (*indexOf)(const void *pool, Entity entity);
+        void (*swapDense)(void *pool, uint32_t a, uint32_t b);
+        std::size_t (*size)(const void *pool);
+        const Entity *(*entities)(const void *pool);
+        PoolStats (*stats)(const void *pool);
+        void (*copyInto)(const void *pool, Scene &target); ///< nullptr if the component is not copyable.
+        void (*instantiate)(const void *pool, Scene &target, const PrefabMapping &map); ///< nullptr likewise.
+        void (*reindex)(void *pool, const CompactReport &report);
+        GroupData *group = nullptr; ///< Owning group, if any.
+    };
+
+    /// Packed prefix shared by the pools of one owning group.
+    struct GroupData
+    {
+        std::vector<PoolStorage *> pools;
+        uint32_t size = 0;
     };
 
     template <typename T> static void RemoveFn(void *pool, Entity entity)
@@ -145,31 +848,431 @@ struct Scene
 
     template <typename T> static void ClearFn(void *pool) { static_cast<SparseSet<T> *>(pool)->Clear(); }
 
-    template <typename T> static void DestroyFn(void *pool) { delete static_cast<SparseSet<T> *>(pool); }
+    template <typename T> static void DestroyFn(void *pool, std::pmr::memory_resource *resource)
+    {
+        std::pmr::polymorphic_allocator<>(resource).delete_object(static_cast<SparseSet<T> *>(pool));
+    }
 
-    /// @brief Returns a pointer to the pool for T, or nullptr if it has never been created.
-    template <typename T> SparseSet<T> *GetPool()
+    template <typename T> static bool HasFn(const void *pool, Entity entity)
+    {
+        return static_cast<const SparseSet<T> *>(pool)->Has(entity);
+    }
+
+    template <typename T> static uint32_t IndexOfFn(const void *pool, Entity entity)
+    {
+        return static_cast<const SparseSet<T> *>(pool)->IndexOf(entity);
+    }
+
+    template <typename T> static void SwapDenseFn(void *pool, uint32_t a, uint32_t b)
+    {
+        static_cast<SparseSet<T> *>(pool)->SwapDense(a, b);
+    }
+
+    template <typename T> static std::size_t SizeFn(const void *pool)
+    {
+        return static_cast<const SparseSet<T> *>(pool)->Size();
+    }
+
+    template <typename T> static const Entity *EntitiesFn(const void *pool)
+    {
+        return static_cast<const SparseSet<T> *>(pool)->Entities().data();
+    }
+
+    template <typename T> static PoolStats StatsFn(const void *pool)
+    {
+        const auto *set = static_cast<const SparseSet<T> *>(pool);
+        const std::size_t sparseBytes = set->SparseBytes();
+        return {ComponentIdOf<T>(), &typeid(T), set->Size(), set->Capacity(), set->MemoryBytes() - sparseBytes,
+                sparseBytes, set->SparseSlots(), set->Budget()};
+    }
+
+    template <typename T> static void CopyIntoFn(const void *pool, Scene &target)
+    {
+        SparseSet<T> &copy = target.GetOrCreatePool<T>();
+        copy.CopyFrom(*static_cast<const SparseSet<T> *>(pool));
+        copy.MarkAllChanged(target._tick);
+    }
+
+    template <typename T> static constexpr void (*CopyIntoOf())(const void *, Scene &)
+    {
+        if constexpr (std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>)
+            return &CopyIntoFn<T>;
+        else
+            return nullptr;
+    }
+
+    /// @brief Offsets of T's reflected EntityRef fields; empty if T is not reflected.
+    static std::vector<std::size_t> EntityRefOffsets(std::type_index type);
+
+    /// @brief Replaces each Entity at `offsets` within the object at `value` with remap(entity).
+    template <typename Remap>
+    static void RemapEntityFields(void *value, std::span<const std::size_t> offsets, Remap &&remap)
+    {
+        auto *bytes = static_cast<std::byte *>(value);
+        for (const std::size_t offset : offsets)
+        {
+            Entity entity;
+            std::memcpy(&entity, bytes + offset, sizeof(Entity));
+            entity = remap(entity);
+            std::memcpy(bytes + offset, &entity, sizeof(Entity));
+        }
+    }
+
+    /// @brief Adds every copy of the mapped sources' T to `target`, with one AddMany().
+    template <typename T> static void InstantiateFn(const void *pool, Scene &target, const PrefabMapping &map)
+    {
+        const auto *set = static_cast<const SparseSet<T> *>(pool);
+
+        /* (ordinal, dense position) of every source that has a T. */
+        std::vector<std::pair<uint32_t, uint32_t>> rows;
+        for (uint32_t ordinal = 0; ordinal < map.sources.size(); ++ordinal)
+        {
+            const uint32_t pos = set->IndexOf(map.sources[ordinal]);
+            if (pos != SparseSet<T>::Invalid && set->Entities()[pos] == map.sources[ordinal])
+                rows.emplace_back(ordinal, pos);
+        }
+        if (rows.empty())
+            return;
+
+        const std::vector<std::size_t> offsets = EntityRefOffsets(typeid(T));
+        std::vector<Entity> entities;
+        std::vector<T> values;
+        entities.reserve(rows.size() * map.copies);
+        values.reserve(rows.size() * map.copies);
+
+        for (std::size_t copy = 0; copy < map.copies; ++copy)
+        {
+            for (const auto &[ordinal, pos] : rows)
+            {
+                entities.push_back(map.targets[copy * map.sources.size() + ordinal]);
+                if constexpr (SoaComponent<T>)
+                    values.push_back(set->Load(pos));
+                else if constexpr (TagComponent<T>)
+                    values.emplace_back();
+                else
+                    values.push_back(set->At(pos));
+
+                if (!offsets.empty())
+                    RemapEntityFields(&values.back(), offsets, [&](Entity e) { return map.Remap(e, copy); });
+            }
+        }
+        (void)target.AddMany<T>(entities, values);
+    }
+
+    /// @brief Renames the pool's entities after Registry::Compact() and rewrites their EntityRef fields.
+    template <typename T> static void ReindexFn(void *pool, const CompactReport &report)
+    {
+        auto *set = static_cast<SparseSet<T> *>(pool);
+        set->Reindex(report.remap);
+
+        const std::vector<std::size_t> offsets = EntityRefOffsets(typeid(T));
+        if (offsets.empty())
+            return;
+
+        const auto remap = [&](Entity e) { return report.Remap(e); };
+        for (uint32_t pos = 0; pos < set->Size(); ++pos)
+        {
+            if constexpr (SoaComponent<T>)
+            {
+                T value = set->Load(pos);
+                RemapEntityFields(&value, offsets, remap);
+                set->Store(pos, value);
+            }
+            else if constexpr (!TagComponent<T>)
+                RemapEntityFields(&set->At(pos), offsets, remap);
+        }
+    }
+
+    template <typename T> static constexpr void (*InstantiateOf())(const void *, Scene &, const PrefabMapping &)
     {
-        auto it = _pools.find(typeid(T));
-        if (it == _pools.end())
+        if constexpr (std::is_copy_constructible_v<T>)
+            return &InstantiateFn<T>;
+        else
             return nullptr;
-        return static_cast<SparseSet<T> *>(it->second.pool);
+    }
+
+    struct ResourceSlot
+    {
+        void *value = nullptr;
+        void (*destroy)(void *value, std::pmr::memory_resource *resource) = nullptr;
+        void (*copyInto)(const void *value, Scene &target) = nullptr; ///< nullptr if the resource is not copyable.
+    };
+
+    template <typename T> static void DestroyResourceFn(void *value, std::pmr::memory_resource *resource)
+    {
+        std::pmr::polymorphic_allocator<>(resource).delete_object(static_cast<T *>(value));
+    }
+
+    template <typename T> static void CopyResourceFn(const void *value, Scene &target)
+    {
+        const T &source = *static_cast<const T *>(value);
+        if (T *existing = target.Resource<T>())
+            *existing = source;
+        else
+            target.SetResource<T>(source);
+    }
+
+    template <typename T> static constexpr void (*CopyResourceOf())(const void *, Scene &)
+    {
+        if constexpr (std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>)
+            return &CopyResourceFn<T>;
+        else
+            return nullptr;
+    }
+
+    struct ComponentSignals
+    {
+        struct Listener
+        {
+            uint32_t id;
+            ComponentListener fn;
+        };
+
+        std::array<std::vector<Listener>, 3> listeners; ///< Indexed by ComponentEvent.
+        bool (*has)(const Scene &scene, Entity entity); ///< For ids that do not fit in a ComponentMask.
+    };
+
+    template <typename T> static bool HasComponentFn(const Scene &scene, Entity entity)
+    {
+        return scene.Has<T>(entity);
+    }
+
+    template <typename T> SignalConnection Connect(ComponentEvent event, ComponentListener listener)
+    {
+        const ComponentId id = ComponentIdOf<T>();
+        if (id >= _signals.size())
+            _signals.resize(id + 1);
+        if (!_signals[id])
+            _signals[id] = std::make_unique<ComponentSignals>(ComponentSignals{{}, &HasComponentFn<T>});
+
+        const uint32_t handle = ++_lastListener;
+        _signals[id]->listeners[static_cast<std::size_t>(event)].push_back({handle, std::move(listener)});
+        if (event == ComponentEvent::Removed)
+            ++_removalListeners;
+        return {id, event, handle};
+    }
+
+    /// @brief Returns the signals of component `id`, or nullptr if nobody listens to it.
+    ComponentSignals *FindSignals(ComponentId id) const
+    {
+        return id < _signals.size() ? _signals[id].get() : nullptr;
+    }
+
+    /// @brief Reports `event` on the entity's component `id`, if anybody listens to it.
+    void Notify(ComponentId id, ComponentEvent event, Entity entity)
+    {
+        if (ComponentSignals *signals = FindSignals(id))
+            Emit(*signals, event, entity);
+    }
+
+    /// @brief Calls every listener of `event`.
+    void Emit(ComponentSignals &signals, ComponentEvent event, Entity entity);
+
+    /// @brief Reports Removed for every listened-to component of a live entity about to be destroyed.
+    void NotifyDestroy(Entity entity);
+
+    /// @brief NotifyDestroy() for each distinct entity of the batch.
+    void NotifyDestroyMany(std::span<const Entity> entities);
+
+    /// @brief Entity tables plus component storage, as compared by Compact().
+    std::size_t StorageBytes() const;
+
+    /// @brief Rewrites the reflected EntityRef fields of every archetype row and resource after a compaction.
+    void RemapCompactedFields(const CompactReport &report);
+
+    /// @brief Returns the resource stored under `id`, or nullptr.
+    void *FindResource(ResourceId id) const { return id < _resources.size() ? _resources[id].value : nullptr; }
+
+    /// @brief Removes the entity from a pool, first moving it out of the pool's group.
+    ///
+    /// Registered with the Registry so Destroy() keeps groups packed too.
+    static void RemoveFromPool(void *storage, Entity entity);
+
+    /// @brief Moves the entity into the packed prefix if it now has every owned component.
+    static void EnterGroup(PoolStorage &storage, Entity entity);
+
+    /// @brief Moves the entity out of the packed prefix before one of its owned components is removed.
+    static void LeaveGroup(PoolStorage &storage, Entity entity);
+
+    /// @brief Creates a group owning `pools` and packs the entities that already qualify.
+    GroupData &CreateGroup(std::vector<PoolStorage *> pools);
+
+    /// @brief Grows the group's packed prefix over every entity that has all its components.
+    static void PackGroup(GroupData &group);
+
+    /// @brief Swaps dense slots a and b of every pool the group owns.
+    static void SwapInGroup(const GroupData &group, uint32_t a, uint32_t b)
+    {
+        for (PoolStorage *pool : group.pools)
+            pool->swapDense(pool->pool, a, b);
+    }
+
+    /// @brief Returns the storage for a component id, or nullptr if its pool has never been created.
+    PoolStorage *FindStorage(ComponentId id) const { return id < _pools.size() ? _pools[id].get() : nullptr; }
+
+    /// @brief Returns a pointer to the pool for T, or nullptr if it has never been created.
+    template <typename T> SparseSet<T> *GetPool() const
+    {
+        const PoolStorage *storage = FindStorage(ComponentIdOf<T>());
+        return storage ? static_cast<SparseSet<T> *>(storage->pool) : nullptr;
     }
 
     template <typename T> SparseSet<T> &GetOrCreatePool()
     {
-        auto it = _pools.find(typeid(T));
-        if (it != _pools.end())
-            return *static_cast<SparseSet<T> *>(it->second.pool);
+        return *static_cast<SparseSet<T> *>(GetOrCreateStorage<T>().pool);
+    }
+
+    template <typename T> PoolStorage &GetOrCreateStorage()
+    {
+        const ComponentId id = ComponentIdOf<T>();
+        if (PoolStorage *storage = FindStorage(id))
+            return *storage;
+
+        if (id >= _pools.size())
+            _pools.resize(id + 1);
+
+        auto *pool = std::pmr::polymorphic_allocator<>(_resource).new_object<SparseSet<T>>(_resource);
+        _pools[id] = std::make_unique<PoolStorage>(PoolStorage{pool, &RemoveFn<T>, &ClearFn<T>, &DestroyFn<T>,
+                                                               &HasFn<T>, &IndexOfFn<T>, &SwapDenseFn<T>, &SizeFn<T>,
+                                                               &EntitiesFn<T>, &StatsFn<T>, CopyIntoOf<T>(),
+                                                               InstantiateOf<T>(), &ReindexFn<T>, nullptr});
 
-        auto *pool = new SparseSet<T>();
-        _registry.RegisterPool(pool);
-        _pools.emplace(typeid(T), PoolStorage{pool, &RemoveFn<T>, &ClearFn<T>, &DestroyFn<T>});
-        return *pool;
+        /* Storages are heap-allocated, so the registry can hold on to them while _pools grows. */
+        _registry.RegisterPool(id, _pools[id].get(), &RemoveFromPool);
+        ++_poolEpoch;
+        return *_pools[id];
     }
 
+    StorageMode _mode = StorageMode::SparseSet;
+    Tick _tick = 1; ///< Starts above 0 so everything counts as added for a system that has never run.
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> _arena;           ///< Set for SceneMemory::Arena.
+    std::pmr::memory_resource *_resource = std::pmr::get_default_resource(); ///< What pools allocate from.
     Registry _registry;
-    std::unordered_map<std::type_index, PoolStorage> _pools;
+    std::vector<std::unique_ptr<PoolStorage>> _pools; ///< Indexed by ComponentId; unused in archetype mode.
+    std::size_t _poolEpoch = 0;                       ///< Number of pools created; see PoolEpoch().
+    std::vector<std::unique_ptr<GroupData>> _groups;
+    ArchetypeStorage _archetypes;                     ///< Unused in sparse-set mode.
+    std::vector<ResourceSlot> _resources;             ///< Indexed by ResourceId.
+    std::vector<std::unique_ptr<ComponentSignals>> _signals; ///< Indexed by ComponentId; null while nobody listens.
+    std::size_t _removalListeners = 0; ///< Connected Removed listeners; Destroy() reports nothing at 0.
+    uint32_t _lastListener = 0;        ///< Id of the most recently connected listener.
+    std::vector<Entity> _dying;        ///< Scratch for NotifyDestroyMany().
+};
+
+/// @brief A Query<Ts...>() kept across frames, returned by Scene::MakeQuery().
+///
+/// Scene::Query() resolves every pool and picks the driving one on each call.
+/// A CachedQuery resolves the pools once, and again only after the scene's
+/// PoolEpoch() changes; each call just re-picks the smallest required pool
+/// (archetype scenes: re-gathers the chunks of the matching archetypes, which
+/// are cached the same way).  The returned view follows the usual rules and
+/// is reused by the next call.
+///
+/// @code
+///   // Member of a system, created once:
+///   ECS::CachedQuery<Position, Velocity> _movers = scene.MakeQuery<Position, Velocity>();
+///
+///   _movers.Each([&](ECS::Entity, Position &pos, const Velocity &vel) { pos.x += vel.x * dt; });
+///   for (auto [e, pos, vel] : _movers()) ...
+/// @endcode
+template <typename... Ts> class CachedQuery
+{
+  public:
+    explicit CachedQuery(Scene &scene) : _scene(&scene) {}
+
+    /// @brief Returns the view for this call; `since` is the Changed/Added reference tick.
+    QueryView<Ts...> &operator()(Tick since = 0)
+    {
+        if (_epoch != _scene->PoolEpoch())
+            Resolve();
+
+        if (_scene->Mode() == StorageMode::Archetype)
+        {
+            _view._chunks.clear();
+            for (const Archetype *archetype : _archetypes)
+            {
+                for (std::size_t chunk = 0; chunk < archetype->ChunkCount(); ++chunk)
+                    _view.AddChunk(*archetype, chunk);
+            }
+        }
+        else
+        {
+            _view.SelectPrimary();
+        }
+        _view._since = since;
+        return _view;
+    }
+
+    /// @brief Calls fn(entity, components...) for every match.
+    ///
+    /// A query for a single plain component in a sparse-set scene walks the
+    /// pool's dense array directly: every entity in the pool matches, so there
+    /// is no membership test and no sparse lookup per entity.  For a single
+    /// tag it walks the pool's entity array alone.
+    template <typename Fn> void Each(Fn &&fn, Tick since = 0)
+    {
+        QueryView<Ts...> &view = (*this)(since);
+
+        /* Plain terms are the only ones whose Storage is the pool of the term type itself. */
+        using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+        if constexpr (sizeof...(Ts) == 1 && !SoaComponent<First> &&
+                      std::is_same_v<typename QueryTerm<First>::Storage, SparseSet<First> *>)
+        {
+            if (_scene->Mode() == StorageMode::SparseSet)
+            {
+                auto *pool = std::get<0>(view._pools);
+                if (!pool)
+                    return;
+
+                const Entity *entities = pool->Entities().data();
+                const std::size_t size = pool->Size();
+                if constexpr (TagComponent<First>)
+                {
+                    for (std::size_t i = 0; i < size; ++i)
+                        fn(entities[i]);
+                }
+                else if constexpr (SparseSet<First>::Contiguous)
+                {
+                    First *data = pool->Data();
+                    for (std::size_t i = 0; i < size; ++i)
+                        fn(entities[i], data[i]);
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < size; ++i)
+                        fn(entities[i], pool->At(static_cast<uint32_t>(i)));
+                }
+                return;
+            }
+        }
+
+        for (auto &&row : view)
+            std::apply(fn, row);
+    }
+
+  private:
+    void Resolve()
+    {
+        _epoch = _scene->PoolEpoch();
+        if (_scene->Mode() == StorageMode::Archetype)
+        {
+            _archetypes.clear();
+            for (const auto &archetype : _scene->_archetypes.Archetypes())
+            {
+                if (QueryView<Ts...>::MatchesArchetype(*archetype))
+                    _archetypes.push_back(archetype.get());
+            }
+        }
+        else
+        {
+            _view = _scene->Query<Ts...>();
+        }
+    }
+
+    Scene *_scene;
+    std::size_t _epoch = SIZE_MAX;              ///< Scene::PoolEpoch() at the last Resolve(); SIZE_MAX = never.
+    QueryView<Ts...> _view{};                   ///< Reused by every call.
+    std::vector<const Archetype *> _archetypes; ///< Matching archetypes (archetype scenes only).
 };
 
 } // namespace Assisi::ECS
@@ -22,11 +22,13 @@ enum class SceneError
 
 struct SceneRegistry
 {
-    /// @brief Creates a new scene with the given name.
+    /// @brief Creates a new scene with the given name, component storage backend and pool memory.
     ///
     /// @return Pointer to the new scene on success, or SceneError::NameAlreadyTaken
     ///         if a scene with that name already exists.
-    [[nodiscard]] std::expected<Scene *, SceneError> Create(std::string_view name);
+    [[nodiscard]] std::expected<Scene *, SceneError> Create(std::string_view name,
+                                                           StorageMode      mode   = StorageMode::SparseSet,
+                                                           SceneMemory      memory = SceneMemory::Heap);
 
     /// @brief Destroys the named scene. Clears the active pointer if it was active.
     void Destroy(std::string_view name);
@@ -0,0 +1,134 @@
+#pragma once
+
+/// @file SoaLayout.hpp
+/// @brief Opt-in structure-of-arrays layout for hot, SIMD-processed components.
+///
+/// By default a SparseSet<T> keeps whole T values next to each other, so a
+/// system that only reads one field still pulls every other field of every
+/// entity through the cache.  Specializing SoaLayout<T> makes the pool store
+/// each listed field in its own array instead, aligned to SoaAlignment so an
+/// AVX2 kernel can stream 8 floats of one field at a time:
+///
+/// @code
+///   struct Particle
+///   {
+///       float x, y, z;
+///       float vx, vy, vz;
+///   };
+///
+///   template <> struct Assisi::ECS::SoaLayout<Particle>
+///   {
+///       using Fields = SoaFields<&Particle::x, &Particle::y, &Particle::z,
+///                                &Particle::vx, &Particle::vy, &Particle::vz>;
+///   };
+///
+///   auto columns = scene.Columns<Particle>();
+///   std::span<float> x = columns.Column<&Particle::x>();
+///   std::span<const float> vx = columns.Column<&Particle::vx>();
+/// @endcode
+///
+/// Declare the specialization right after the component, before anything
+/// instantiates a pool for it.  Only listed fields are stored: a field left out
+/// reads back default-initialized.  SoA components cannot be handed out as T&,
+/// so Get() and queries yield a SoaRef<T> (see SparseSet.hpp) instead.
+/// Columns() covers the whole pool; for a kernel over only the entities that
+/// also match other terms, QueryView::EachChunk() hands out a SoaSpan<T> per
+/// run, whose Column<&T::x>() is that run of the field:
+///
+/// @code
+///   scene.Query<Particle, Emitting>().EachChunk(
+///       [](std::span<const ECS::Entity>, ECS::SoaSpan<Particle> particles)
+///       {
+///           std::span<float> x = particles.Column<&Particle::x>();
+///           std::span<const float> vx = particles.Column<&Particle::vx>();
+///           for (std::size_t i = 0; i < x.size(); ++i)
+///               x[i] += vx[i];
+///       });
+/// @endcode
+
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+
+namespace Assisi::ECS
+{
+
+/// @brief Byte alignment of every SoA field array: one 256-bit AVX2 register.
+inline constexpr std::size_t SoaAlignment = 32;
+
+/// @brief Allocator drawing storage aligned to max(Alignment, alignof(T)) from a std::pmr::memory_resource.
+///
+/// Follows polymorphic_allocator semantics: copies share the resource and
+/// containers never propagate it on assignment.
+template <typename T, std::size_t Alignment> struct AlignedAllocator
+{
+    using value_type = T;
+
+    static constexpr std::size_t Align = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    template <typename U> struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    AlignedAllocator(std::pmr::memory_resource *resource) noexcept : _resource(resource) {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &other) noexcept : _resource(other._resource)
+    {
+    }
+
+    T *allocate(std::size_t count) { return static_cast<T *>(_resource->allocate(count * sizeof(T), Align)); }
+    void deallocate(T *ptr, std::size_t count) noexcept { _resource->deallocate(ptr, count * sizeof(T), Align); }
+
+    template <typename U> bool operator==(const AlignedAllocator<U, Alignment> &other) const noexcept
+    {
+        return _resource == other._resource;
+    }
+
+    std::pmr::memory_resource *_resource = std::pmr::get_default_resource();
+};
+
+/// @brief The list of fields a SoA pool stores, as pointers to members of the component.
+template <auto... Members> struct SoaFields
+{
+};
+
+/// @brief Specialize with `using Fields = SoaFields<&T::a, &T::b, ...>` to store T field-by-field.
+template <typename T> struct SoaLayout
+{
+};
+
+/// @brief True for components whose pool uses the structure-of-arrays layout.
+template <typename T>
+concept SoaComponent = requires { typename SoaLayout<T>::Fields; };
+
+template <typename M> struct MemberPointer;
+
+template <typename C, typename F> struct MemberPointer<F C::*>
+{
+    using Class = C;
+    using Field = F;
+};
+
+/// @brief Type of the field a pointer to member refers to: `SoaFieldType<&Particle::x>` is float.
+template <auto Member> using SoaFieldType = typename MemberPointer<decltype(Member)>::Field;
+
+/// @brief True if A and B point to the same member (different member types never do).
+template <auto A, auto B> constexpr bool IsSameMember()
+{
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>)
+        return A == B;
+    else
+        return false;
+}
+
+/// @brief Position of Member within Members, or sizeof...(Members) if it is not listed.
+template <auto Member, auto... Members> constexpr std::size_t SoaFieldIndex()
+{
+    std::size_t index = 0;
+    const bool found = (... || (IsSameMember<Member, Members>() || (++index, false)));
+    return found ? index : sizeof...(Members);
+}
+
+} // namespace Assisi::ECS
@@ -11,48 +11,414 @@
 ///   dense[pos]            → component value
 ///   entities[pos]         → entity index that owns dense[pos]
 ///
+/// The sparse array is paged: entity indices are split into fixed-size pages
+/// that are allocated the first time a component is added in their range.
+/// Untouched pages all point at one shared, read-only page of Invalid entries,
+/// so lookups never branch on a missing page and a rare component living on a
+/// high entity index costs one page instead of a slot for every lower index.
+///
 /// Remove() swaps the target element with the last one and pops, keeping
 /// the dense array gap-free at all times.
+///
+/// Every component also carries ComponentTicks, stored in a third array
+/// parallel to dense: the tick it was added at and the tick it was last
+/// marked changed at.  Query filters (Changed<T>, Added<T>) compare them
+/// against a system's last-run tick.
+///
+/// The dense array is a std::pmr::vector<T> unless DenseStorage<T> selects
+/// the pointer-stable PagedVector (see DenseStorage.hpp).  Empty component
+/// types (tags) get a TagVector, which stores no values at all: Get() returns
+/// a pointer to one shared instance and queries treat tags as pure filters.
+///
+/// All of a set's memory comes from the std::pmr::memory_resource it was
+/// constructed with (the default resource unless Scene passes its own).  A set
+/// can be given a byte budget: Add() then fails with BudgetExceeded instead of
+/// growing past it, and MemoryBytes() reports what the set currently holds.
+///
+/// Components with a SoaLayout specialization get a second layout,
+/// SoaSparseSet, that stores each field in its own aligned array (see
+/// SoaLayout.hpp).
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <memory_resource>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <Assisi/ECS/DenseStorage.hpp>
 #include <Assisi/ECS/Entity.hpp>
+#include <Assisi/ECS/SoaLayout.hpp>
 
 namespace Assisi::ECS
 {
 
+/// @brief Monotonic scene-wide change counter.  Compared with IsNewerTick() so wrap-around is harmless.
+using Tick = uint32_t;
+
+/// @brief Returns true if `tick` is later than `since`, treating the counter as wrapping.
+///
+/// Correct as long as the two are less than 2^31 ticks apart.
+constexpr bool IsNewerTick(Tick tick, Tick since)
+{
+    return static_cast<int32_t>(tick - since) > 0;
+}
+
+/// @brief Change-detection state of one stored component.
+struct ComponentTicks
+{
+    Tick added;   ///< Tick at which the component was added.
+    Tick changed; ///< Tick of the last MarkChanged() (or of the Add).
+};
+
 enum class SparseSetError
 {
-    AlreadyExists, ///< Returned by Add() if the entity already has a component.
+    AlreadyExists,       ///< Returned by Add() if the entity already has a component.
+    SizeMismatch,        ///< Returned by Scene::AddMany() if the entity and component spans differ in length.
+    SoaInArchetypeScene, ///< Returned by Scene::Add() for SoA components, which archetype chunks cannot store.
+    BudgetExceeded,      ///< Returned by Add() if growing the pool would take it past its byte budget.
+    NotAlive,            ///< Returned by Scene::Add() for a stale or null entity handle.
+};
+
+/// @brief Capacity a full pool container grows to: doubling, starting at 8.
+constexpr std::size_t NextPoolCapacity(std::size_t capacity)
+{
+    return std::max<std::size_t>(8, capacity * 2);
+}
+
+/// @brief Bytes a pool container holds, counting unused capacity.
+template <typename C> std::size_t PoolCapacityBytes(const C &container)
+{
+    if (std::is_empty_v<typename C::value_type>)
+        return 0;
+    return container.capacity() * sizeof(typename C::value_type);
+}
+
+/// @brief Bytes ReserveForOne() is about to allocate for `container`.
+template <typename C> std::size_t PoolGrowthBytes(const C &container)
+{
+    if (std::is_empty_v<typename C::value_type> || container.size() < container.capacity())
+        return 0;
+    if constexpr (std::ranges::contiguous_range<C>)
+        return (NextPoolCapacity(container.capacity()) - container.capacity()) * sizeof(typename C::value_type);
+    else if constexpr (requires { C::PageLength; })
+        return C::PageLength * sizeof(typename C::value_type);
+    else
+        return 0;
+}
+
+/// @brief Makes room for one more element.
+///
+/// Contiguous containers grow by NextPoolCapacity() rather than by the
+/// library's own factor, so PoolGrowthBytes() is exact and budgets can be
+/// checked before anything is allocated.
+template <typename C> void ReserveForOne(C &container)
+{
+    if (container.size() == container.capacity())
+        container.reserve(std::ranges::contiguous_range<C> ? NextPoolCapacity(container.capacity())
+                                                           : container.size() + 1);
+}
+
+/// @brief Sorts dense positions [first, last) by less(a, b), moving elements only through swap(a, b).
+///
+/// The sort is stable, and an already sorted range costs one linear check,
+/// so re-sorting every frame is cheap while the order holds.
+template <typename Less, typename Swap> void SortDenseRange(uint32_t first, uint32_t last, Less less, Swap swap)
+{
+    if (last <= first + 1)
+        return;
+
+    std::vector<uint32_t> order(last - first);
+    std::iota(order.begin(), order.end(), first);
+    if (std::ranges::is_sorted(order, less))
+        return;
+    std::ranges::stable_sort(order, less);
+
+    /* Apply the permutation cycle by cycle: position first + i receives the element now at order[i]. */
+    for (uint32_t i = 0; i < order.size(); ++i)
+    {
+        uint32_t j = i;
+        while (order[j] != first + i)
+        {
+            const uint32_t k = order[j] - first;
+            swap(first + j, first + k);
+            order[j] = first + j;
+            j        = k;
+        }
+        order[j] = first + j;
+    }
+}
+
+/// @brief Paged map from entity index to dense position, shared by both SparseSet layouts.
+struct SparsePages
+{
+    /// @brief Sentinel stored for indices with no component.
+    static constexpr uint32_t Invalid = UINT32_MAX;
+
+    /// @brief Number of entity indices covered by one page (16 KB per page).
+    static constexpr uint32_t PageSize = 4096;
+
+    explicit SparsePages(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : _pages(resource)
+    {
+    }
+
+    SparsePages(const SparsePages &other) : SparsePages(other, other.Resource()) {}
+
+    SparsePages(const SparsePages &other, std::pmr::memory_resource *resource) : _pages(resource)
+    {
+        CopyFrom(other);
+    }
+
+    SparsePages(SparsePages &&other) noexcept
+        : _pages(std::move(other._pages)), _pageCount(std::exchange(other._pageCount, 0)),
+          _extent(std::exchange(other._extent, 0))
+    {
+        other._pages.clear();
+    }
+
+    /// Assignment keeps this object's memory resource, like a std::pmr container.
+    ///
+    /// Copy assignment reuses the pages this object already has, so copying
+    /// into the same set over and over (snapshots) allocates nothing.
+    SparsePages &operator=(const SparsePages &other)
+    {
+        if (this == &other)
+            return *this;
+
+        for (std::size_t page = other._pages.size(); page < _pages.size(); ++page)
+            FreePage(page);
+        _pages.resize(other._pages.size(), &NullPage);
+
+        for (std::size_t page = 0; page < _pages.size(); ++page)
+        {
+            if (other._pages[page] == &NullPage)
+                FreePage(page);
+            else if (_pages[page] == &NullPage)
+                _pages[page] = NewPage(*other._pages[page]);
+            else
+                *_pages[page] = *other._pages[page];
+        }
+        _pageCount = other._pageCount;
+        _extent    = other._extent;
+        return *this;
+    }
+
+    SparsePages &operator=(SparsePages &&other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        if (Resource() != other.Resource())
+            return *this = static_cast<const SparsePages &>(other);
+
+        Clear();
+        std::swap(_pages, other._pages);
+        std::swap(_pageCount, other._pageCount);
+        std::swap(_extent, other._extent);
+        return *this;
+    }
+
+    ~SparsePages() { Clear(); }
+
+    /// @brief Reads the dense position for an entity index, or Invalid.
+    uint32_t Lookup(uint32_t index) const
+    {
+        const std::size_t page = index / PageSize;
+        return page < _pages.size() ? (*_pages[page])[index % PageSize] : Invalid;
+    }
+
+    /// @brief Returns a writable slot, allocating its page on first use.
+    uint32_t &Slot(uint32_t index)
+    {
+        const std::size_t page = index / PageSize;
+        if (page >= _pages.size())
+            _pages.resize(page + 1, &NullPage);
+
+        if (_pages[page] == &NullPage)
+        {
+            _pages[page] = NewPage(NullPage);
+            ++_pageCount;
+        }
+        _extent = std::max(_extent, static_cast<std::size_t>(index) + 1);
+        return (*_pages[page])[index % PageSize];
+    }
+
+    /// @brief Sets every index back to Invalid, keeping the pages and page table for reuse.
+    void Reset()
+    {
+        for (Page *page : _pages)
+        {
+            if (page != &NullPage)
+                page->fill(Invalid);
+        }
+        _extent = 0;
+    }
+
+    /// @brief Frees every page, leaving all indices Invalid.
+    void Clear()
+    {
+        for (std::size_t page = 0; page < _pages.size(); ++page)
+            FreePage(page);
+        _pages.clear();
+        _pageCount = 0;
+        _extent    = 0;
+    }
+
+    /// @brief Rebuilds the map from scratch so entities[pos] maps to pos, with no page or table slack.
+    void Rebuild(std::span<const Entity> entities)
+    {
+        Clear();
+        for (std::size_t pos = 0; pos < entities.size(); ++pos)
+            Slot(entities[pos].index) = static_cast<uint32_t>(pos);
+        _pages.shrink_to_fit();
+    }
+
+    /// @brief Bytes currently held: the page table plus every allocated page.
+    std::size_t Bytes() const { return _pages.capacity() * sizeof(Page *) + _pageCount * sizeof(Page); }
+
+    /// @brief Entity indices covered by the allocated pages.
+    std::size_t SlotCount() const { return _pageCount * PageSize; }
+
+    /// @brief Bytes a flat array (one slot per index up to the highest one used) would need.
+    std::size_t FlatBytes() const { return _extent * sizeof(uint32_t); }
+
+    /// @brief Bytes Slot(index) would allocate: a page if the index's page is untouched, plus page table growth.
+    std::size_t GrowthBytes(uint32_t index) const
+    {
+        const std::size_t page = index / PageSize;
+        if (page < _pages.size())
+            return _pages[page] == &NullPage ? sizeof(Page) : 0;
+
+        const std::size_t table = page + 1 > _pages.capacity() ? (page + 1 - _pages.capacity()) * sizeof(Page *) : 0;
+        return table + sizeof(Page);
+    }
+
+    /// @brief The memory resource pages and the page table are allocated from.
+    std::pmr::memory_resource *Resource() const { return _pages.get_allocator().resource(); }
+
+  private:
+    using Page = std::array<uint32_t, PageSize>;
+
+    /// Shared by every untouched page slot of every set; never written.
+    static inline Page NullPage = []
+    {
+        Page page;
+        page.fill(Invalid);
+        return page;
+    }();
+
+    Page *NewPage(const Page &contents) const
+    {
+        return ::new (Resource()->allocate(sizeof(Page), alignof(Page))) Page(contents);
+    }
+
+    /// @brief Returns one page to the resource, leaving its indices Invalid.  Does not touch _pageCount.
+    void FreePage(std::size_t page)
+    {
+        if (_pages[page] == &NullPage)
+            return;
+        Resource()->deallocate(_pages[page], sizeof(Page), alignof(Page));
+        _pages[page] = &NullPage;
+    }
+
+    void CopyFrom(const SparsePages &other)
+    {
+        _pages.reserve(other._pages.size());
+        for (const Page *page : other._pages)
+            _pages.push_back(page == &NullPage ? &NullPage : NewPage(*page));
+        _pageCount = other._pageCount;
+        _extent    = other._extent;
+    }
+
+    std::pmr::vector<Page *> _pages; ///< Indexed by entity index / PageSize → page of dense positions.
+    std::size_t _pageCount = 0;      ///< Pages allocated (excluding NullPage).
+    std::size_t _extent    = 0;      ///< Highest entity index written since the last Clear() or Reset(), plus one.
 };
 
 template <typename T> struct SparseSet
 {
 
     /// @brief Sentinel stored in the sparse array for slots with no component.
-    static constexpr uint32_t Invalid = UINT32_MAX;
+    static constexpr uint32_t Invalid = SparsePages::Invalid;
+
+    /// @brief Number of entity indices covered by one sparse page (16 KB per page).
+    static constexpr uint32_t PageSize = SparsePages::PageSize;
+
+    /// @brief Container holding the packed components, chosen by DenseStorage<T>.
+    using Dense = typename DenseStorage<T>::Type;
+
+    /// @brief True if the components are one contiguous array (Data() is available).
+    static constexpr bool Contiguous = std::ranges::contiguous_range<Dense>;
+
+    /// @brief True for empty component types, which store no values (see TagVector).
+    static constexpr bool Tag = std::is_empty_v<T>;
+
+    /// @brief Paged pools page their ticks too, so only the entity array is ever copied by growth.
+    using TickStorage = std::conditional_t<Contiguous || Tag, std::pmr::vector<ComponentTicks>,
+                                           PagedVector<ComponentTicks, DefaultDensePageSize<ComponentTicks>>>;
+
+    SparseSet() = default;
+
+    /// @brief Creates an empty set allocating from `resource`.
+    explicit SparseSet(std::pmr::memory_resource *resource)
+        : _sparse(resource), _dense(resource), _entities(resource), _ticks(resource)
+    {
+    }
+
+    /// Copies allocate from the source's memory resource.
+    SparseSet(const SparseSet &other) : SparseSet(other, other.Resource()) {}
+
+    SparseSet(const SparseSet &other, std::pmr::memory_resource *resource)
+        : _sparse(other._sparse, resource), _dense(other._dense, resource), _entities(other._entities, resource),
+          _ticks(other._ticks, resource), _budget(other._budget)
+    {
+    }
+
+    SparseSet(SparseSet &&) noexcept = default;
+
+    /// Assignment keeps this set's memory resource.
+    SparseSet &operator=(const SparseSet &) = default;
+    SparseSet &operator=(SparseSet &&)      = default;
+
+    /// @brief Replaces the stored components with `other`'s, keeping this set's budget and memory resource.
+    void CopyFrom(const SparseSet &other)
+    {
+        _sparse   = other._sparse;
+        _dense    = other._dense;
+        _entities = other._entities;
+        _ticks    = other._ticks;
+    }
 
     /// @brief Adds a component for the given entity.
     ///
-    /// @return Pointer to the new component on success, or
-    ///         SparseSetError::AlreadyExists if the entity already has one.
-    [[nodiscard]] std::expected<T *, SparseSetError> Add(Entity entity, T component = {})
+    /// Both of the component's ticks are set to `tick`.
+    /// @return Pointer to the new component on success,
+    ///         SparseSetError::AlreadyExists if the entity already has one, or
+    ///         SparseSetError::BudgetExceeded if there is no room left in the budget.
+    [[nodiscard]] std::expected<T *, SparseSetError> Add(Entity entity, T component = {}, Tick tick = 0)
     {
         if (Has(entity))
             return std::unexpected(SparseSetError::AlreadyExists);
+        if (_budget != 0 && MemoryBytes() + GrowthBytes(entity.index) > _budget)
+            return std::unexpected(SparseSetError::BudgetExceeded);
 
-        /* Grow the sparse array to accommodate the entity index if needed. */
-        if (entity.index >= _sparse.size())
-            _sparse.resize(entity.index + 1, Invalid);
+        ReserveForOne(_dense);
+        ReserveForOne(_entities);
+        ReserveForOne(_ticks);
 
         /* Record where in the dense array this entity's component will live. */
-        _sparse[entity.index] = static_cast<uint32_t>(_dense.size());
+        _sparse.Slot(entity.index) = static_cast<uint32_t>(_dense.size());
 
         /* Append the entity index and the component value. */
         _entities.push_back(entity);
+        _ticks.emplace_back(ComponentTicks{tick, tick});
         return &_dense.emplace_back(component);
     }
 
@@ -65,7 +431,7 @@ template <typename T> struct SparseSet
         if (!Has(entity))
             return;
 
-        const uint32_t removedPos = _sparse[entity.index];
+        const uint32_t removedPos = _sparse.Lookup(entity.index);
         const uint32_t lastPos = static_cast<uint32_t>(_dense.size()) - 1;
 
         if (removedPos != lastPos)
@@ -73,34 +439,34 @@ template <typename T> struct SparseSet
             /* Move the last element into the removed slot. */
             _dense[removedPos]    = std::move(_dense[lastPos]);
             _entities[removedPos] = _entities[lastPos];
+            _ticks[removedPos]    = _ticks[lastPos];
 
             /* Update the sparse entry for the entity that was moved. */
-            _sparse[_entities[removedPos].index] = removedPos;
+            _sparse.Slot(_entities[removedPos].index) = removedPos;
         }
 
         /* Clear the sparse entry and shrink the dense arrays. */
-        _sparse[entity.index] = Invalid;
+        _sparse.Slot(entity.index) = Invalid;
         _dense.pop_back();
         _entities.pop_back();
+        _ticks.pop_back();
     }
 
     /// @brief Returns true if the entity has a component in this set.
-    bool Has(Entity entity) const { return entity.index < _sparse.size() && _sparse[entity.index] != Invalid; }
+    bool Has(Entity entity) const { return _sparse.Lookup(entity.index) != Invalid; }
 
     /// @brief Returns a pointer to the entity's component, or nullptr if not present.
     T *Get(Entity entity)
     {
-        if (!Has(entity))
-            return nullptr;
-        return &_dense[_sparse[entity.index]];
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        return pos != Invalid ? &_dense[pos] : nullptr;
     }
 
     /// @brief Returns a const pointer to the entity's component, or nullptr if not present.
     const T *Get(Entity entity) const
     {
-        if (!Has(entity))
-            return nullptr;
-        return &_dense[_sparse[entity.index]];
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        return pos != Invalid ? &_dense[pos] : nullptr;
     }
 
     /// @brief Returns the number of components currently stored.
@@ -109,27 +475,566 @@ template <typename T> struct SparseSet
     /// @brief Returns true if no components are stored.
     bool Empty() const { return _dense.empty(); }
 
+    /// @brief Reserves dense capacity for at least `capacity` components.
+    ///
+    /// Does nothing if that would take the set past its budget.
+    void Reserve(std::size_t capacity)
+    {
+        const std::size_t extra = capacity > _entities.capacity() ? capacity - _entities.capacity() : 0;
+        const std::size_t rowBytes = (Tag ? 0 : sizeof(T)) + sizeof(Entity) + sizeof(ComponentTicks);
+        if (_budget != 0 && MemoryBytes() + extra * rowBytes > _budget)
+            return;
+
+        _dense.reserve(capacity);
+        _entities.reserve(capacity);
+        _ticks.reserve(capacity);
+    }
+
+    /// @brief Bytes currently held by the set: sparse pages plus the capacity of every dense array.
+    std::size_t MemoryBytes() const
+    {
+        return _sparse.Bytes() + PoolCapacityBytes(_dense) + PoolCapacityBytes(_entities) + PoolCapacityBytes(_ticks);
+    }
+
+    /// @brief Components the dense arrays hold before they grow.
+    std::size_t Capacity() const { return _entities.capacity(); }
+
+    /// @brief Entity indices covered by the allocated sparse pages; compare with Size() for occupancy.
+    std::size_t SparseSlots() const { return _sparse.SlotCount(); }
+
+    /// @brief Caps MemoryBytes(); Add() fails rather than grow past it.  0 (the default) means unlimited.
+    ///
+    /// Memory already held above a new, lower budget is not released.
+    void SetBudget(std::size_t bytes) { _budget = bytes; }
+
+    /// @brief The byte budget, or 0 if unlimited.
+    std::size_t Budget() const { return _budget; }
+
+    /// @brief The memory resource everything in the set is allocated from.
+    std::pmr::memory_resource *Resource() const { return _entities.get_allocator().resource(); }
+
     /// @brief Iterators over the dense component array for cache-friendly iteration.
-    std::vector<T>::iterator begin() { return _dense.begin(); }
-    std::vector<T>::iterator end() { return _dense.end(); }
-    std::vector<T>::const_iterator begin() const { return _dense.begin(); }
-    std::vector<T>::const_iterator end() const { return _dense.end(); }
+    Dense::iterator begin() { return _dense.begin(); }
+    Dense::iterator end() { return _dense.end(); }
+    Dense::const_iterator begin() const { return _dense.begin(); }
+    Dense::const_iterator end() const { return _dense.end(); }
 
-    /// @brief Removes all components, resetting the set to an empty state.
+    /// @brief Removes all components, keeping every allocation so the set refills without reallocating.
     void Clear()
     {
-        _sparse.clear();
+        _sparse.Reset();
         _dense.clear();
         _entities.clear();
+        _ticks.clear();
+    }
+
+    /// @brief Renames every stored entity e to remap[e.index], then releases all spare capacity.
+    ///
+    /// Dense order is kept.  Used by Scene::Compact(); every stored index must be in `remap`.
+    void Reindex(std::span<const Entity> remap)
+    {
+        for (Entity &entity : _entities)
+            entity = remap[entity.index];
+        _sparse.Rebuild(_entities);
+        _dense.shrink_to_fit();
+        _entities.shrink_to_fit();
+        _ticks.shrink_to_fit();
     }
 
+    /// @brief Stamps the entity's component as changed at `tick`.  Does nothing if not present.
+    void MarkChanged(Entity entity, Tick tick)
+    {
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        if (pos != Invalid)
+            _ticks[pos].changed = tick;
+    }
+
+    /// @brief Stamps every component in the pool as changed at `tick`.
+    void MarkAllChanged(Tick tick)
+    {
+        for (std::size_t pos = 0; pos < _ticks.size(); ++pos)
+            _ticks[pos].changed = tick;
+    }
+
+    /// @brief Returns the entity's component ticks, or nullptr if not present.
+    const ComponentTicks *Ticks(Entity entity) const
+    {
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        return pos != Invalid ? &_ticks[pos] : nullptr;
+    }
+
+    /// @brief Bytes currently held by the sparse side: the page table plus every allocated page.
+    std::size_t SparseBytes() const { return _sparse.Bytes(); }
+
+    /// @brief Bytes a flat sparse array (one slot per index up to the highest one used) would need.
+    ///
+    /// SparseBytes() compared against this is the memory saved by paging.
+    std::size_t FlatSparseBytes() const { return _sparse.FlatBytes(); }
+
     /// @brief Direct access to the packed entity array (parallel to dense).
-    const std::vector<Entity> &Entities() const { return _entities; }
+    const std::pmr::vector<Entity> &Entities() const { return _entities; }
+
+    /// @brief Direct access to the packed component array (parallel to Entities()).  Contiguous storage only.
+    T *Data()
+        requires Contiguous
+    {
+        return _dense.data();
+    }
+    const T *Data() const
+        requires Contiguous
+    {
+        return _dense.data();
+    }
+
+    /// @brief The component at dense position `pos` (parallel to Entities()).
+    T &At(uint32_t pos) { return _dense[pos]; }
+    const T &At(uint32_t pos) const { return _dense[pos]; }
+
+    /// @brief Returns the entity's position in the dense array, or Invalid if not present.
+    uint32_t IndexOf(Entity entity) const { return _sparse.Lookup(entity.index); }
+
+    /// @brief Reorders the components so `compare` holds from front to back.
+    ///
+    /// `compare` is a strict weak order over `const T &` or over Entity.  The
+    /// sparse array stays consistent and ticks move with their components.
+    /// Like Remove(), this invalidates pointers into the pool.
+    template <typename Compare> void Sort(Compare compare)
+    {
+        Sort(0, static_cast<uint32_t>(Size()), compare, [this](uint32_t a, uint32_t b) { SwapDense(a, b); });
+    }
+
+    /// @brief Sorts dense positions [first, last) only, moving slots with swap(a, b).
+    ///
+    /// `swap` must at least SwapDense(a, b) this pool; Scene passes one that
+    /// moves a group's other pools in step.
+    template <typename Compare, typename Swap> void Sort(uint32_t first, uint32_t last, Compare compare, Swap swap)
+    {
+        if constexpr (std::is_invocable_r_v<bool, Compare &, const T &, const T &>)
+            SortDenseRange(first, last, [&](uint32_t a, uint32_t b) { return compare(_dense[a], _dense[b]); }, swap);
+        else
+            SortDenseRange(
+                first, last, [&](uint32_t a, uint32_t b) { return compare(_entities[a], _entities[b]); }, swap);
+    }
+
+    /// @brief Swaps two dense slots (component and owning entity), keeping the sparse array consistent.
+    void SwapDense(uint32_t a, uint32_t b)
+    {
+        if (a == b)
+            return;
+
+        std::swap(_dense[a], _dense[b]);
+        std::swap(_entities[a], _entities[b]);
+        std::swap(_ticks[a], _ticks[b]);
+        _sparse.Slot(_entities[a].index) = a;
+        _sparse.Slot(_entities[b].index) = b;
+    }
+
+  private:
+    /// @brief Bytes the next Add() for `index` allocates.
+    std::size_t GrowthBytes(uint32_t index) const
+    {
+        return _sparse.GrowthBytes(index) + PoolGrowthBytes(_dense) + PoolGrowthBytes(_entities) +
+               PoolGrowthBytes(_ticks);
+    }
+
+    SparsePages _sparse;                ///< Entity index → dense position.
+    Dense _dense;                       ///< Packed component values.
+    std::pmr::vector<Entity> _entities; ///< Entity that owns each dense slot.
+    TickStorage _ticks;                 ///< Change ticks of each dense slot.
+    std::size_t _budget = 0;            ///< Cap on MemoryBytes(); 0 = unlimited.
+};
+
+template <typename T, typename Fields> struct SoaSparseSet;
+
+/// @brief The storage behind SparseSet<T> for a SoaComponent T.
+template <typename T> using SoaStorage = SoaSparseSet<T, typename SoaLayout<T>::Fields>;
+
+/// @brief Handle to one entity's component in a SoA pool; yielded by Get() and queries instead of T&.
+///
+/// The fields live in separate arrays, so there is no T object to point at:
+/// access a field in place with Field<&T::x>(), or copy the whole component
+/// out with Load() and back with Store().  Default-constructed (and tested
+/// false) when the component is absent.  Invalidated like a pointer by any
+/// structural change to the pool.  SoaRef<const T> is the read-only form.
+template <typename T> struct SoaRef
+{
+    using Value = std::remove_const_t<T>;
+    using Pool  = std::conditional_t<std::is_const_v<T>, const SoaStorage<Value>, SoaStorage<Value>>;
+
+    Pool *_pool   = nullptr;
+    uint32_t _pos = 0;
+
+    explicit operator bool() const { return _pool != nullptr; }
+
+    /// @brief Reference to one field of the component, e.g. `ref.Field<&Particle::x>() += 1.f`.
+    template <auto Member> auto &Field() const { return _pool->template At<Member>(_pos); }
+
+    /// @brief Gathers the stored fields into a T.
+    Value Load() const { return _pool->Load(_pos); }
+
+    /// @brief Scatters every stored field of `value` into the pool.
+    void Store(const Value &value) const
+        requires(!std::is_const_v<T>)
+    {
+        _pool->Store(_pos, value);
+    }
+
+    template <typename U = T>
+        requires(!std::is_const_v<U>)
+    operator SoaRef<const U>() const
+    {
+        return {_pool, _pos};
+    }
+};
+
+/// @brief True for empty component types: pure markers whose pools store no values.
+template <typename T>
+concept TagComponent = std::is_empty_v<T> && !SoaComponent<T>;
+
+/// @brief What a pool hands out for a component: T* normally, SoaRef<T> for SoA components.
+template <typename T>
+using ComponentRef = std::conditional_t<SoaComponent<std::remove_const_t<T>>, SoaRef<T>, T *>;
+
+/// @brief SparseSet layout for SoA components: one SoaAlignment-aligned array per listed field.
+///
+/// Same sparse paging, tick tracking and swap-and-pop removal as the default
+/// layout, but no T is ever materialised in storage.  Column<&T::x>() exposes
+/// one field of every stored component as a contiguous span, in the order of
+/// Entities().
+template <typename T, auto... Members> struct SoaSparseSet<T, SoaFields<Members...>>
+{
+    static_assert(sizeof...(Members) > 0, "SoaLayout<T>::Fields must list at least one field");
+    static_assert((... && std::is_same_v<typename MemberPointer<decltype(Members)>::Class, T>),
+                  "SoaLayout<T>::Fields must only list members of T");
+    static_assert((... && !std::is_same_v<SoaFieldType<Members>, bool>),
+                  "bool fields cannot be stored as SoA columns; use uint8_t");
+
+    static constexpr uint32_t Invalid = SparsePages::Invalid;
+
+    SoaSparseSet() = default;
+
+    /// @brief Creates an empty set allocating from `resource`.
+    explicit SoaSparseSet(std::pmr::memory_resource *resource)
+        : _sparse(resource), _columns(ColumnVector<SoaFieldType<Members>>(resource)...), _entities(resource),
+          _ticks(resource)
+    {
+    }
+
+    /// Copies allocate from the source's memory resource.
+    SoaSparseSet(const SoaSparseSet &other) : SoaSparseSet(other, other.Resource()) {}
+
+    SoaSparseSet(const SoaSparseSet &other, std::pmr::memory_resource *resource)
+        : _sparse(other._sparse, resource),
+          _columns(ColumnVector<SoaFieldType<Members>>(other.template ColumnOf<Members>(), resource)...),
+          _entities(other._entities, resource), _ticks(other._ticks, resource), _budget(other._budget)
+    {
+    }
+
+    SoaSparseSet(SoaSparseSet &&) noexcept = default;
+
+    /// Assignment keeps this set's memory resource.
+    SoaSparseSet &operator=(const SoaSparseSet &) = default;
+    SoaSparseSet &operator=(SoaSparseSet &&)      = default;
+
+    /// @brief Replaces the stored components with `other`'s, keeping this set's budget and memory resource.
+    void CopyFrom(const SoaSparseSet &other)
+    {
+        _sparse   = other._sparse;
+        _columns  = other._columns;
+        _entities = other._entities;
+        _ticks    = other._ticks;
+    }
+
+    /// @brief Adds a component for the given entity, scattering its fields into the columns.
+    /// @return Handle to the new component on success,
+    ///         SparseSetError::AlreadyExists if the entity already has one, or
+    ///         SparseSetError::BudgetExceeded if there is no room left in the budget.
+    [[nodiscard]] std::expected<SoaRef<T>, SparseSetError> Add(Entity entity, const T &component = {}, Tick tick = 0)
+    {
+        if (Has(entity))
+            return std::unexpected(SparseSetError::AlreadyExists);
+        if (_budget != 0 && MemoryBytes() + GrowthBytes(entity.index) > _budget)
+            return std::unexpected(SparseSetError::BudgetExceeded);
+
+        std::apply([](auto &...column) { (ReserveForOne(column), ...); }, _columns);
+        ReserveForOne(_entities);
+        ReserveForOne(_ticks);
+
+        const auto pos = static_cast<uint32_t>(_entities.size());
+        _sparse.Slot(entity.index) = pos;
+        _entities.push_back(entity);
+        _ticks.push_back({tick, tick});
+        (ColumnOf<Members>().push_back(component.*Members), ...);
+        return SoaRef<T>{this, pos};
+    }
+
+    /// @brief Removes the component for the given entity (swap-and-pop in every column).
+    void Remove(Entity entity)
+    {
+        const uint32_t removedPos = _sparse.Lookup(entity.index);
+        if (removedPos == Invalid)
+            return;
+
+        const uint32_t lastPos = static_cast<uint32_t>(_entities.size()) - 1;
+        if (removedPos != lastPos)
+        {
+            std::apply([&](auto &...column) { ((column[removedPos] = std::move(column[lastPos])), ...); },
+                       _columns);
+            _entities[removedPos] = _entities[lastPos];
+            _ticks[removedPos]    = _ticks[lastPos];
+            _sparse.Slot(_entities[removedPos].index) = removedPos;
+        }
+
+        _sparse.Slot(entity.index) = Invalid;
+        std::apply([](auto &...column) { (column.pop_back(), ...); }, _columns);
+        _entities.pop_back();
+        _ticks.pop_back();
+    }
+
+    /// @brief Returns true if the entity has a component in this set.
+    bool Has(Entity entity) const { return _sparse.Lookup(entity.index) != Invalid; }
+
+    /// @brief Returns a handle to the entity's component, or an empty handle if not present.
+    SoaRef<T> Get(Entity entity)
+    {
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        return pos != Invalid ? SoaRef<T>{this, pos} : SoaRef<T>{};
+    }
+
+    /// @brief Returns a read-only handle to the entity's component, or an empty handle if not present.
+    SoaRef<const T> Get(Entity entity) const
+    {
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        return pos != Invalid ? SoaRef<const T>{this, pos} : SoaRef<const T>{};
+    }
+
+    /// @brief Returns the number of components currently stored.
+    std::size_t Size() const { return _entities.size(); }
+
+    /// @brief Returns true if no components are stored.
+    bool Empty() const { return _entities.empty(); }
+
+    /// @brief Reserves capacity for at least `capacity` components in every column.
+    ///
+    /// Does nothing if that would take the set past its budget.
+    void Reserve(std::size_t capacity)
+    {
+        const std::size_t extra = capacity > _entities.capacity() ? capacity - _entities.capacity() : 0;
+        const std::size_t rowBytes = (... + sizeof(SoaFieldType<Members>)) + sizeof(Entity) + sizeof(ComponentTicks);
+        if (_budget != 0 && MemoryBytes() + extra * rowBytes > _budget)
+            return;
+
+        std::apply([&](auto &...column) { (column.reserve(capacity), ...); }, _columns);
+        _entities.reserve(capacity);
+        _ticks.reserve(capacity);
+    }
+
+    /// @brief Bytes currently held by the set: sparse pages plus the capacity of every column.
+    std::size_t MemoryBytes() const
+    {
+        const std::size_t columns =
+            std::apply([](const auto &...column) { return (... + PoolCapacityBytes(column)); }, _columns);
+        return _sparse.Bytes() + columns + PoolCapacityBytes(_entities) + PoolCapacityBytes(_ticks);
+    }
+
+    /// @brief Components the columns hold before they grow.
+    std::size_t Capacity() const { return _entities.capacity(); }
+
+    /// @brief Entity indices covered by the allocated sparse pages; compare with Size() for occupancy.
+    std::size_t SparseSlots() const { return _sparse.SlotCount(); }
+
+    /// @brief Caps MemoryBytes(); Add() fails rather than grow past it.  0 (the default) means unlimited.
+    void SetBudget(std::size_t bytes) { _budget = bytes; }
+
+    /// @brief The byte budget, or 0 if unlimited.
+    std::size_t Budget() const { return _budget; }
+
+    /// @brief The memory resource everything in the set is allocated from.
+    std::pmr::memory_resource *Resource() const { return _entities.get_allocator().resource(); }
+
+    /// @brief Removes all components, keeping every allocation so the set refills without reallocating.
+    void Clear()
+    {
+        _sparse.Reset();
+        std::apply([](auto &...column) { (column.clear(), ...); }, _columns);
+        _entities.clear();
+        _ticks.clear();
+    }
+
+    /// @brief Renames every stored entity and releases spare capacity; see SparseSet::Reindex().
+    void Reindex(std::span<const Entity> remap)
+    {
+        for (Entity &entity : _entities)
+            entity = remap[entity.index];
+        _sparse.Rebuild(_entities);
+        std::apply([](auto &...column) { (column.shrink_to_fit(), ...); }, _columns);
+        _entities.shrink_to_fit();
+        _ticks.shrink_to_fit();
+    }
+
+    /// @brief Stamps the entity's component as changed at `tick`.  Does nothing if not present.
+    void MarkChanged(Entity entity, Tick tick)
+    {
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        if (pos != Invalid)
+            _ticks[pos].changed = tick;
+    }
+
+    /// @brief Stamps every component in the pool as changed at `tick`.
+    void MarkAllChanged(Tick tick)
+    {
+        for (std::size_t pos = 0; pos < _ticks.size(); ++pos)
+            _ticks[pos].changed = tick;
+    }
+
+    /// @brief Returns the entity's component ticks, or nullptr if not present.
+    const ComponentTicks *Ticks(Entity entity) const
+    {
+        const uint32_t pos = _sparse.Lookup(entity.index);
+        return pos != Invalid ? &_ticks[pos] : nullptr;
+    }
+
+    /// @brief Bytes currently held by the sparse side: the page table plus every allocated page.
+    std::size_t SparseBytes() const { return _sparse.Bytes(); }
+
+    /// @brief Bytes a flat sparse array would need; see SparseSet::FlatSparseBytes().
+    std::size_t FlatSparseBytes() const { return _sparse.FlatBytes(); }
+
+    /// @brief Direct access to the packed entity array (parallel to every column).
+    const std::pmr::vector<Entity> &Entities() const { return _entities; }
+
+    /// @brief Returns the entity's position in the columns, or Invalid if not present.
+    uint32_t IndexOf(Entity entity) const { return _sparse.Lookup(entity.index); }
+
+    /// @brief Reorders the components so `compare` (over `const T &` or Entity) holds from front to back.
+    ///
+    /// Component comparisons gather both operands with Load(); compare by
+    /// Entity, or read Column()s inside the comparator, when that matters.
+    template <typename Compare> void Sort(Compare compare)
+    {
+        Sort(0, static_cast<uint32_t>(Size()), compare, [this](uint32_t a, uint32_t b) { SwapDense(a, b); });
+    }
+
+    /// @brief Sorts dense positions [first, last) only, moving slots with swap(a, b).
+    template <typename Compare, typename Swap> void Sort(uint32_t first, uint32_t last, Compare compare, Swap swap)
+    {
+        if constexpr (std::is_invocable_r_v<bool, Compare &, const T &, const T &>)
+            SortDenseRange(first, last, [&](uint32_t a, uint32_t b) { return compare(Load(a), Load(b)); }, swap);
+        else
+            SortDenseRange(
+                first, last, [&](uint32_t a, uint32_t b) { return compare(_entities[a], _entities[b]); }, swap);
+    }
+
+    /// @brief Swaps two dense slots in every column, keeping the sparse array consistent.
+    void SwapDense(uint32_t a, uint32_t b)
+    {
+        if (a == b)
+            return;
+
+        std::apply([&](auto &...column) { (std::swap(column[a], column[b]), ...); }, _columns);
+        std::swap(_entities[a], _entities[b]);
+        std::swap(_ticks[a], _ticks[b]);
+        _sparse.Slot(_entities[a].index) = a;
+        _sparse.Slot(_entities[b].index) = b;
+    }
+
+    /// @brief One field of every stored component, aligned with Entities() and starting on a SoaAlignment boundary.
+    ///
+    /// Writing through the span does not mark components changed.
+    template <auto Member> std::span<SoaFieldType<Member>> Column() { return ColumnOf<Member>(); }
+    template <auto Member> std::span<const SoaFieldType<Member>> Column() const { return ColumnOf<Member>(); }
+
+    /// @brief The field `Member` of the component at dense position `pos`.
+    template <auto Member> SoaFieldType<Member> &At(uint32_t pos) { return ColumnOf<Member>()[pos]; }
+    template <auto Member> const SoaFieldType<Member> &At(uint32_t pos) const { return ColumnOf<Member>()[pos]; }
+
+    /// @brief Gathers the component at dense position `pos`; unlisted fields are default-initialized.
+    T Load(uint32_t pos) const
+    {
+        T value{};
+        ((value.*Members = ColumnOf<Members>()[pos]), ...);
+        return value;
+    }
+
+    /// @brief Scatters `value` into dense position `pos`.
+    void Store(uint32_t pos, const T &value) { ((ColumnOf<Members>()[pos] = value.*Members), ...); }
 
   private:
-    std::vector<uint32_t> _sparse; ///< Indexed by entity index → dense position.
-    std::vector<T> _dense;         ///< Packed component values.
-    std::vector<Entity> _entities; ///< Entity that owns each dense slot.
+    template <typename F> using ColumnVector = std::vector<F, AlignedAllocator<F, SoaAlignment>>;
+
+    /// @brief Bytes the next Add() for `index` allocates.
+    std::size_t GrowthBytes(uint32_t index) const
+    {
+        const std::size_t columns =
+            std::apply([](const auto &...column) { return (... + PoolGrowthBytes(column)); }, _columns);
+        return _sparse.GrowthBytes(index) + columns + PoolGrowthBytes(_entities) + PoolGrowthBytes(_ticks);
+    }
+
+    template <auto Member> auto &ColumnOf()
+    {
+        static_assert(SoaFieldIndex<Member, Members...>() < sizeof...(Members),
+                      "Member is not listed in SoaLayout<T>::Fields");
+        return std::get<SoaFieldIndex<Member, Members...>()>(_columns);
+    }
+
+    template <auto Member> const auto &ColumnOf() const
+    {
+        static_assert(SoaFieldIndex<Member, Members...>() < sizeof...(Members),
+                      "Member is not listed in SoaLayout<T>::Fields");
+        return std::get<SoaFieldIndex<Member, Members...>()>(_columns);
+    }
+
+    SparsePages _sparse;                                         ///< Entity index → dense position.
+    std::tuple<ColumnVector<SoaFieldType<Members>>...> _columns; ///< One packed array per listed field.
+    std::pmr::vector<Entity> _entities;                          ///< Entity that owns each dense slot.
+    std::pmr::vector<ComponentTicks> _ticks;                     ///< Change ticks of each dense slot.
+    std::size_t _budget = 0;                                     ///< Cap on MemoryBytes(); 0 = unlimited.
+};
+
+template <typename T>
+    requires SoaComponent<T>
+struct SparseSet<T> : SoaStorage<T>
+{
+    using SoaStorage<T>::SoaStorage;
+};
+
+/// @brief The field columns of one SoA pool, as returned by Scene::Columns<T>().
+///
+/// Empty when the pool has not been created.  Every span is aligned with
+/// Entities(); kernels process Size() / 8 full AVX2 blocks, then the tail.
+template <typename T> struct SoaColumns
+{
+    SoaStorage<T> *_pool;
+
+    std::size_t Size() const { return _pool ? _pool->Size() : 0; }
+
+    std::span<const Entity> Entities() const
+    {
+        return _pool ? std::span<const Entity>(_pool->Entities()) : std::span<const Entity>{};
+    }
+
+    template <auto Member> std::span<SoaFieldType<Member>> Column() const
+    {
+        return _pool ? _pool->template Column<Member>() : std::span<SoaFieldType<Member>>{};
+    }
+};
+
+/// @brief A run of `count` consecutive components of one SoA pool, as handed out by QueryView::EachChunk().
+///
+/// Column<&T::x>() is that run of one field.  Spans start at dense position
+/// `first`, so only a run starting at 0 is guaranteed SoaAlignment-aligned.
+template <typename T> struct SoaSpan
+{
+    SoaStorage<T> *_pool = nullptr;
+    uint32_t _first = 0;
+    std::size_t _count = 0;
+
+    std::size_t size() const { return _count; }
+
+    template <auto Member> std::span<SoaFieldType<Member>> Column() const
+    {
+        return _pool ? _pool->template Column<Member>().subspan(_first, _count) : std::span<SoaFieldType<Member>>{};
+    }
 };
 
 } // namespace Assisi::ECS
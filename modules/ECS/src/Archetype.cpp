@@ -0,0 +1,344 @@
+/* Copyright (c) 2025 Francisco Vivas Puerto (aka "DaFrancc"). */
+
+#include <algorithm>
+#include <cstring>
+
+#include <Assisi/ECS/Archetype.hpp>
+
+namespace Assisi::ECS
+{
+
+namespace
+{
+
+std::size_t AlignUp(std::size_t value, std::size_t align)
+{
+    return (value + align - 1) / align * align;
+}
+
+/* Byte size of a chunk holding `capacity` rows, columns aligned for their types. */
+std::size_t ChunkFootprint(const std::vector<const ComponentInfo *> &components, std::size_t capacity,
+                           std::vector<std::size_t> *offsets)
+{
+    std::size_t bytes = sizeof(Entity) * capacity;
+    for (const ComponentInfo *info : components)
+    {
+        bytes = AlignUp(bytes, info->align);
+        if (offsets)
+            offsets->push_back(bytes);
+        bytes += info->size * capacity;
+    }
+    return bytes;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Archetype
+// ---------------------------------------------------------------------------
+
+Archetype::Archetype(std::vector<const ComponentInfo *> components) : _components(std::move(components))
+{
+    /* Start from the unpadded estimate, then back off until the aligned layout fits. */
+    std::size_t rowBytes = sizeof(Entity);
+    for (const ComponentInfo *info : _components)
+        rowBytes += info->size;
+
+    std::size_t capacity = std::max<std::size_t>(1, ChunkBytes / rowBytes);
+    while (capacity > 1 && ChunkFootprint(_components, capacity, nullptr) > ChunkBytes)
+        --capacity;
+
+    _capacity   = static_cast<uint32_t>(capacity);
+    _chunkBytes = std::max(ChunkBytes, ChunkFootprint(_components, capacity, &_offsets));
+}
+
+int Archetype::ColumnIndex(std::type_index type) const
+{
+    /* Signatures are a handful of types; a linear scan beats hashing here. */
+    for (std::size_t i = 0; i < _components.size(); ++i)
+    {
+        if (_components[i]->type == type)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+uint32_t Archetype::AppendRow(Entity entity)
+{
+    const uint32_t row = _size;
+    const std::size_t chunk = row / _capacity;
+
+    /* Chunks are only freed by Reindex() and destruction, so reuse one left over from a Clear(). */
+    if (chunk == _chunks.size())
+        AddChunk();
+
+    Entities(chunk)[row % _capacity] = entity;
+    ++_size;
+    return row;
+}
+
+Entity Archetype::EraseRow(uint32_t row)
+{
+    const uint32_t last = _size - 1;
+    Entity moved = NullEntity;
+
+    if (row != last)
+    {
+        for (std::size_t column = 0; column < _components.size(); ++column)
+            _components[column]->relocate(At(column, row), At(column, last));
+
+        moved = EntityAt(last);
+        Entities(row / _capacity)[row % _capacity] = moved;
+    }
+
+    --_size;
+    return moved;
+}
+
+void Archetype::DestroyRows()
+{
+    for (std::size_t column = 0; column < _components.size(); ++column)
+    {
+        /* Trivially copyable implies trivially destructible: nothing to run. */
+        if (_components[column]->trivial)
+            continue;
+        for (uint32_t row = 0; row < _size; ++row)
+            _components[column]->destroy(At(column, row));
+    }
+    _size = 0;
+}
+
+void Archetype::CopyRows(const Archetype &other)
+{
+    const std::size_t chunks = other.ChunkCount();
+    while (_chunks.size() < chunks)
+        AddChunk();
+
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        const std::size_t rows = other.ChunkSize(chunk);
+        std::memcpy(Entities(chunk), other.Entities(chunk), rows * sizeof(Entity));
+
+        for (std::size_t column = 0; column < _components.size(); ++column)
+        {
+            const ComponentInfo *info = _components[column];
+            auto *to = static_cast<std::byte *>(Column(chunk, column));
+            const auto *from = static_cast<const std::byte *>(other.Column(chunk, column));
+
+            if (info->trivial)
+                std::memcpy(to, from, rows * info->size);
+            else
+            {
+                for (std::size_t row = 0; row < rows; ++row)
+                    info->copy(to + row * info->size, from + row * info->size);
+            }
+        }
+    }
+    _size = other._size;
+}
+
+void Archetype::AddChunk()
+{
+    auto *memory = static_cast<std::byte *>(::operator new(_chunkBytes, std::align_val_t{ChunkAlign}));
+    _chunks.emplace_back(memory);
+}
+
+// ---------------------------------------------------------------------------
+// ArchetypeStorage
+// ---------------------------------------------------------------------------
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+    Clear();
+}
+
+void *ArchetypeStorage::Insert(Entity entity, const ComponentInfo &info)
+{
+    if (entity.index >= _locations.size())
+        _locations.resize(entity.index + 1);
+
+    Location &location = _locations[entity.index];
+    if (location.archetype && location.archetype->Has(info.type))
+        return nullptr;
+
+    Archetype &target = Transition(location.archetype, info, /*add=*/true);
+    const uint32_t row = MoveEntity(entity, location, target);
+    return target.At(static_cast<std::size_t>(target.ColumnIndex(info.type)), row);
+}
+
+void ArchetypeStorage::Erase(Entity entity, const ComponentInfo &info)
+{
+    if (entity.index >= _locations.size())
+        return;
+
+    Location &location = _locations[entity.index];
+    if (!location.archetype || !location.archetype->Has(info.type))
+        return;
+
+    Archetype &target = Transition(location.archetype, info, /*add=*/false);
+    MoveEntity(entity, location, target);
+}
+
+void *ArchetypeStorage::Find(Entity entity, std::type_index type) const
+{
+    if (entity.index >= _locations.size())
+        return nullptr;
+
+    const Location &location = _locations[entity.index];
+    if (!location.archetype)
+        return nullptr;
+
+    const int column = location.archetype->ColumnIndex(type);
+    if (column < 0)
+        return nullptr;
+    return location.archetype->At(static_cast<std::size_t>(column), location.row);
+}
+
+void ArchetypeStorage::RemoveEntity(Entity entity)
+{
+    if (entity.index >= _locations.size())
+        return;
+
+    Location &location = _locations[entity.index];
+    Archetype *archetype = location.archetype;
+    if (!archetype)
+        return;
+
+    for (std::size_t column = 0; column < archetype->Components().size(); ++column)
+        archetype->Components()[column]->destroy(archetype->At(column, location.row));
+
+    const Entity moved = archetype->EraseRow(location.row);
+    if (moved != NullEntity)
+        _locations[moved.index].row = location.row;
+
+    location = {};
+}
+
+void ArchetypeStorage::Clear()
+{
+    for (auto &archetype : _archetypes)
+        archetype->DestroyRows();
+    _locations.clear();
+}
+
+void ArchetypeStorage::Reindex(std::span<const Entity> remap, std::size_t count)
+{
+    std::vector<Location> locations(count);
+    for (auto &archetype : _archetypes)
+    {
+        for (uint32_t row = 0; row < archetype->Size(); ++row)
+        {
+            Entity &entity = archetype->Entities(row / archetype->Capacity())[row % archetype->Capacity()];
+            entity = remap[entity.index];
+            locations[entity.index] = {archetype.get(), row};
+        }
+        archetype->_chunks.resize(archetype->ChunkCount());
+        archetype->_chunks.shrink_to_fit();
+    }
+    _locations = std::move(locations);
+}
+
+bool ArchetypeStorage::CopyFrom(const ArchetypeStorage &other)
+{
+    if (this == &other)
+        return true;
+
+    for (const auto &archetype : other._archetypes)
+    {
+        if (archetype->Size() == 0)
+            continue;
+        for (const ComponentInfo *info : archetype->Components())
+        {
+            if (!info->copy)
+                return false;
+        }
+    }
+
+    for (auto &archetype : _archetypes)
+        archetype->DestroyRows();
+
+    /* Rows keep their positions, so locations are rebuilt from the copied entity columns. */
+    _locations.assign(other._locations.size(), Location{});
+    for (const auto &archetype : other._archetypes)
+    {
+        /* Archetypes are matched by signature, so restoring into the same storage reuses all of them. */
+        Archetype &target = FindOrCreate(archetype->Components());
+        target.CopyRows(*archetype);
+
+        for (std::size_t chunk = 0; chunk < target.ChunkCount(); ++chunk)
+        {
+            const Entity *entities = target.Entities(chunk);
+            const uint32_t first = static_cast<uint32_t>(chunk) * target.Capacity();
+            for (uint32_t row = 0; row < target.ChunkSize(chunk); ++row)
+                _locations[entities[row].index] = {&target, first + row};
+        }
+    }
+    return true;
+}
+
+uint32_t ArchetypeStorage::MoveEntity(Entity entity, Location &location, Archetype &target)
+{
+    const uint32_t newRow = target.AppendRow(entity);
+
+    if (Archetype *source = location.archetype)
+    {
+        for (std::size_t column = 0; column < source->Components().size(); ++column)
+        {
+            const ComponentInfo *info = source->Components()[column];
+            void *from = source->At(column, location.row);
+
+            const int targetColumn = target.ColumnIndex(info->type);
+            if (targetColumn >= 0)
+                info->relocate(target.At(static_cast<std::size_t>(targetColumn), newRow), from);
+            else
+                info->destroy(from);
+        }
+
+        /* Fill the hole left in the source archetype and fix up whoever moved into it. */
+        const Entity moved = source->EraseRow(location.row);
+        if (moved != NullEntity)
+            _locations[moved.index].row = location.row;
+    }
+
+    location = {&target, newRow};
+    return newRow;
+}
+
+Archetype &ArchetypeStorage::Transition(Archetype *from, const ComponentInfo &info, bool add)
+{
+    if (from)
+    {
+        auto &edges = add ? from->_addEdges : from->_removeEdges;
+        if (auto it = edges.find(info.type); it != edges.end())
+            return *it->second;
+    }
+
+    std::vector<const ComponentInfo *> components = from ? from->Components() : std::vector<const ComponentInfo *>{};
+    if (add)
+    {
+        const auto pos = std::ranges::lower_bound(components, info.type, {}, &ComponentInfo::type);
+        components.insert(pos, &info);
+    }
+    else
+    {
+        std::erase(components, &info);
+    }
+
+    Archetype &to = FindOrCreate(std::move(components));
+    if (from)
+        (add ? from->_addEdges : from->_removeEdges).emplace(info.type, &to);
+    return to;
+}
+
+Archetype &ArchetypeStorage::FindOrCreate(std::vector<const ComponentInfo *> components)
+{
+    for (const auto &archetype : _archetypes)
+    {
+        if (archetype->Components() == components)
+            return *archetype;
+    }
+
+    return *_archetypes.emplace_back(std::make_unique<Archetype>(std::move(components)));
+}
+
+} // namespace Assisi::ECS
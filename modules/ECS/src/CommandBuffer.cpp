@@ -0,0 +1,117 @@
+/* Copyright (c) 2025 Francisco Vivas Puerto (aka "DaFrancc"). */
+
+#include <Assisi/Core/JobSystem.hpp>
+#include <Assisi/ECS/CommandBuffer.hpp>
+
+namespace Assisi::ECS
+{
+
+void CommandBuffer::Playback(Scene &scene)
+{
+    scene.FlushReserved();
+    ResolvePending(scene);
+    ApplyCommands(scene);
+    scene.DestroyMany(_destroyed);
+    Reset();
+}
+
+void CommandBuffer::Reset()
+{
+    /* Payloads were moved from by playback (or never used); either way they still need destroying. */
+    for (const Command &command : _commands)
+    {
+        if (command.destroy)
+            command.destroy(command.payload);
+    }
+
+    _commands.clear();
+    _destroyed.clear();
+    _spawnCount = 0;
+    _largeBlocks.clear();
+    _block  = 0;
+    _offset = 0;
+}
+
+void *CommandBuffer::Allocate(std::size_t size, std::size_t align)
+{
+    if (size > BlockSize)
+        return _largeBlocks.emplace_back(NewBlock(size)).get();
+
+    std::size_t offset = (_offset + align - 1) & ~(align - 1);
+    if (_block == _blocks.size() || offset + size > BlockSize)
+    {
+        /* Move on to the next block, reusing the ones kept from earlier playbacks. */
+        if (_block < _blocks.size())
+            ++_block;
+        if (_block == _blocks.size())
+            _blocks.push_back(NewBlock(BlockSize));
+        offset = 0;
+    }
+
+    _offset = offset + size;
+    return _blocks[_block].get() + offset;
+}
+
+CommandBuffer::Block CommandBuffer::NewBlock(std::size_t size)
+{
+    return Block(static_cast<std::byte *>(::operator new(size, std::align_val_t{BlockAlignment})));
+}
+
+void CommandBuffer::ResolvePending(Scene &scene)
+{
+    if (_spawnCount == 0)
+        return;
+
+    _spawned.resize(_spawnCount);
+    scene.CreateMany(_spawned);
+
+    /* NullEntity also carries PendingGeneration, but its index is never below _spawnCount. */
+    auto resolve = [this](Entity &entity)
+    {
+        if (entity.generation == PendingGeneration && entity.index < _spawnCount)
+            entity = _spawned[entity.index];
+    };
+    for (Command &command : _commands)
+        resolve(command.entity);
+    for (Entity &entity : _destroyed)
+        resolve(entity);
+}
+
+void CommandBuffer::ApplyCommands(Scene &scene)
+{
+    for (const Command &command : _commands)
+        command.apply(scene, command.payload, command.entity);
+}
+
+ThreadCommandBuffers::ThreadCommandBuffers() : _buffers(Core::JobSystem::Instance().WorkerCount() + 1) {}
+
+CommandBuffer &ThreadCommandBuffers::Local()
+{
+    return _buffers[Core::JobSystem::ThreadIndex()];
+}
+
+void ThreadCommandBuffers::Playback(Scene &scene)
+{
+    /* Entities reserved by the phase's systems are recorded against by handle; make them alive first. */
+    scene.FlushReserved();
+
+    for (CommandBuffer &buffer : _buffers)
+    {
+        if (buffer.Empty())
+            continue;
+
+        buffer.ResolvePending(scene);
+        buffer.ApplyCommands(scene);
+        _destroyed.insert(_destroyed.end(), buffer._destroyed.begin(), buffer._destroyed.end());
+        buffer.Reset();
+    }
+
+    /* One pool-major sweep for every destroy recorded by every thread. */
+    if (!_destroyed.empty())
+    {
+        scene.DestroyMany(_destroyed);
+        _destroyed.clear();
+    }
+}
+
+} // namespace Assisi::ECS
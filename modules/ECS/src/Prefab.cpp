@@ -0,0 +1,95 @@
+/* Copyright (c) 2025 Francisco Vivas Puerto (aka "DaFrancc"). */
+
+#include <Assisi/ECS/Prefab.hpp>
+
+namespace Assisi::ECS
+{
+
+std::expected<Prefab, PrefabError> Prefab::FromEntities(const Scene &source, std::span<const Entity> entities)
+{
+    if (source.Mode() != StorageMode::SparseSet)
+        return std::unexpected(PrefabError::ArchetypeStorage);
+
+    std::vector<Entity> sources;
+    std::vector<uint32_t> ordinals;
+    for (const Entity entity : entities)
+    {
+        if (!source.IsAlive(entity))
+            continue;
+        if (entity.index >= ordinals.size())
+            ordinals.resize(entity.index + 1, UINT32_MAX);
+        if (ordinals[entity.index] != UINT32_MAX)
+            continue;
+
+        ordinals[entity.index] = static_cast<uint32_t>(sources.size());
+        sources.push_back(entity);
+    }
+
+    if (!Copyable(source, sources))
+        return std::unexpected(PrefabError::NotCopyable);
+
+    Prefab prefab;
+    std::vector<Entity> targets(sources.size());
+    prefab._template->CreateMany(targets);
+    /* The template is a world of its own: handles into the source scene would alias template entities. */
+    CopyComponents(source, *prefab._template, {sources, ordinals, targets, 1, true});
+    return prefab;
+}
+
+std::expected<void, PrefabError> Prefab::Instantiate(Scene &target, std::span<Entity> out) const
+{
+    std::vector<Entity> sources;
+    _template->_registry.CollectAlive(sources);
+    if (sources.empty() || out.size() % sources.size() != 0)
+    {
+        if (out.empty())
+            return {};
+        return std::unexpected(PrefabError::SizeMismatch);
+    }
+
+    if (!Copyable(*_template, sources))
+        return std::unexpected(PrefabError::NotCopyable);
+
+    /* CollectAlive() lists in index order, so the last source has the highest index. */
+    std::vector<uint32_t> ordinals(sources.back().index + 1, UINT32_MAX);
+    for (uint32_t ordinal = 0; ordinal < sources.size(); ++ordinal)
+        ordinals[sources[ordinal].index] = ordinal;
+
+    target.CreateMany(out);
+    CopyComponents(*_template, target, {sources, ordinals, out, out.size() / sources.size()});
+    return {};
+}
+
+std::expected<std::vector<Entity>, PrefabError> Prefab::Instantiate(Scene &target, std::size_t count) const
+{
+    std::vector<Entity> out(count * EntityCount());
+    if (auto result = Instantiate(target, out); !result)
+        return std::unexpected(result.error());
+    return out;
+}
+
+bool Prefab::Copyable(const Scene &source, std::span<const Entity> sources)
+{
+    for (const auto &storage : source._pools)
+    {
+        if (!storage || storage->instantiate)
+            continue;
+        for (const Entity entity : sources)
+        {
+            if (storage->has(storage->pool, entity))
+                return false;
+        }
+    }
+    return true;
+}
+
+void Prefab::CopyComponents(const Scene &source, Scene &target, const Scene::PrefabMapping &map)
+{
+    for (const auto &storage : source._pools)
+    {
+        if (storage && storage->size(storage->pool) != 0)
+            storage->instantiate(storage->pool, target, map);
+    }
+}
+
+} // namespace Assisi::ECS
@@ -9,50 +9,188 @@ namespace Assisi::ECS
 
 Entity Registry::Create()
 {
-    if (!_freeSlots.empty())
-    {
-        /* Reuse a previously freed slot. */
-        const uint32_t index = _freeSlots.back();
-        _freeSlots.pop_back();
+    Flush();
+    ++_aliveCount;
 
-        ++_aliveCount;
+    if (_flushedHead != NoSlot)
+    {
+        /* Reuse the most recently freed slot. */
+        const uint32_t index = _flushedHead;
+        _flushedHead         = _slots[index].nextFree;
+        _freeHead.store(_flushedHead, std::memory_order_relaxed);
 
         /* Return the slot with its current generation, which was incremented
            when the previous occupant was destroyed. */
-        return {.index = index, .generation = _generations[index]};
+        return {.index = index, .generation = _slots[index].generation};
     }
 
-    /* No free slots — grow the generations array with a new slot at index 0. */
-    const auto index = static_cast<uint32_t>(_generations.size());
-    _generations.push_back(0);
-
-    ++_aliveCount;
+    /* No free slots — grow the slot table with a new slot at generation 0. */
+    const auto index = static_cast<uint32_t>(_slots.size());
+    _slots.push_back({0, NoSlot});
+    _masks.emplace_back();
+    _freshEnd.store(index + 1, std::memory_order_relaxed);
     return {.index = index, .generation = 0};
 }
 
+Entity Registry::Reserve()
+{
+    /* Nothing pushes onto the list while reservations are running, so a popped
+       slot cannot reappear under a stale head (no ABA), and slots are only read. */
+    uint32_t head = _freeHead.load(std::memory_order_acquire);
+    while (head != NoSlot)
+    {
+        if (_freeHead.compare_exchange_weak(head, _slots[head].nextFree, std::memory_order_acquire))
+            return {.index = head, .generation = _slots[head].generation};
+    }
+
+    return {.index = _freshEnd.fetch_add(1, std::memory_order_relaxed), .generation = 0};
+}
+
+void Registry::FlushReserved()
+{
+    /* The slots popped since the last flush are exactly the list from the old head to the new one. */
+    const uint32_t head = _freeHead.load(std::memory_order_acquire);
+    for (uint32_t index = _flushedHead; index != head; index = _slots[index].nextFree)
+        ++_aliveCount;
+    _flushedHead = head;
+
+    const uint32_t end = _freshEnd.load(std::memory_order_acquire);
+    if (end > _slots.size())
+    {
+        _aliveCount += end - _slots.size();
+        _slots.resize(end, Slot{0, NoSlot});
+        _masks.resize(end);
+    }
+}
+
+void Registry::CreateMany(std::span<Entity> out)
+{
+    Flush();
+    std::size_t written = 0;
+
+    /* Reuse free slots first, newest first, exactly like Create(). */
+    while (written < out.size() && _flushedHead != NoSlot)
+    {
+        const uint32_t index = _flushedHead;
+        _flushedHead         = _slots[index].nextFree;
+        out[written++]       = {.index = index, .generation = _slots[index].generation};
+    }
+    _freeHead.store(_flushedHead, std::memory_order_relaxed);
+
+    /* Append the rest as fresh slots in one go. */
+    const std::size_t fresh = out.size() - written;
+    const auto first = static_cast<uint32_t>(_slots.size());
+    _slots.resize(_slots.size() + fresh, Slot{0, NoSlot});
+    _masks.resize(_masks.size() + fresh);
+    _freshEnd.store(static_cast<uint32_t>(_slots.size()), std::memory_order_relaxed);
+    for (std::size_t i = 0; i < fresh; ++i)
+        out[written + i] = {.index = first + static_cast<uint32_t>(i), .generation = 0};
+
+    _aliveCount += out.size();
+}
+
 void Registry::Destroy(Entity entity)
 {
+    Flush();
     if (!IsAlive(entity))
     {
         return;
     }
 
+    /* Only visit the pools the entity is actually in.  A bit may have no pool
+       (archetype scenes track masks without registering pools). */
+    _masks[entity.index].ForEach(
+        [&](ComponentId id)
+        {
+            if (id < _componentPools.size() && _componentPools[id].pool)
+                _componentPools[id].remove(_componentPools[id].pool, entity);
+        });
+    _masks[entity.index] = {};
+
     for (auto &entry : _pools)
     {
         entry.remove(entry.pool, entity);
     }
 
     /* Bump the generation so any stored handles to this entity become stale. */
-    ++_generations[entity.index];
+    ++_slots[entity.index].generation;
 
     /* Make the slot available for the next Create() call. */
-    _freeSlots.push_back(entity.index);
+    Release(entity.index);
 
     --_aliveCount;
 }
 
+void Registry::DestroyMany(std::span<const Entity> entities)
+{
+    /* Retire the handles up front: bumping the generation makes a duplicate
+       later in the batch fail IsAlive(), so it is only processed once. */
+    Flush();
+    _dying.clear();
+    ComponentMask touched;
+    for (Entity entity : entities)
+    {
+        if (!IsAlive(entity))
+            continue;
+
+        ++_slots[entity.index].generation;
+        _dying.push_back(entity);
+        touched |= _masks[entity.index];
+    }
+
+    /* Pool-major sweep: each pool is visited once for the whole batch. */
+    touched.ForEach(
+        [&](ComponentId id)
+        {
+            if (id >= _componentPools.size() || !_componentPools[id].pool)
+                return;
+
+            const PoolEntry &entry = _componentPools[id];
+            for (Entity entity : _dying)
+            {
+                if (_masks[entity.index].Test(id))
+                    entry.remove(entry.pool, entity);
+            }
+        });
+
+    for (auto &entry : _pools)
+    {
+        for (Entity entity : _dying)
+            entry.remove(entry.pool, entity);
+    }
+
+    for (Entity entity : _dying)
+    {
+        _masks[entity.index] = {};
+        Release(entity.index);
+    }
+    _aliveCount -= _dying.size();
+}
+
+void Registry::RegisterPool(ComponentId id, void *pool, void (*remove)(void *pool, Entity entity))
+{
+    if (!ComponentMask::Fits(id))
+    {
+        _pools.push_back({pool, remove});
+        return;
+    }
+
+    if (id >= _componentPools.size())
+        _componentPools.resize(id + 1, PoolEntry{nullptr, nullptr});
+    _componentPools[id] = {pool, remove};
+}
+
 void Registry::UnregisterPool(void *pool)
 {
+    for (auto &entry : _componentPools)
+    {
+        if (entry.pool == pool)
+        {
+            entry = {nullptr, nullptr};
+            return;
+        }
+    }
+
     auto iter = std::ranges::find_if(_pools, [pool](const PoolEntry &entry) { return entry.pool == pool; });
     if (iter != _pools.end())
     {
@@ -63,7 +201,7 @@ void Registry::UnregisterPool(void *pool)
 bool Registry::IsAlive(Entity entity) const
 {
     /* Bounds check first to safely handle NullEntity and out-of-range indices. */
-    return entity.index < _generations.size() && _generations[entity.index] == entity.generation;
+    return entity.index < _slots.size() && _slots[entity.index].generation == entity.generation;
 }
 
 std::size_t Registry::AliveCount() const
@@ -71,4 +209,63 @@ std::size_t Registry::AliveCount() const
     return _aliveCount;
 }
 
+std::vector<bool> Registry::FreeSlots() const
+{
+    /* A free slot looks like a live one; only the free list tells them apart. */
+    std::vector<bool> free(_slots.size(), false);
+    for (uint32_t index = _flushedHead; index != NoSlot; index = _slots[index].nextFree)
+        free[index] = true;
+    return free;
+}
+
+void Registry::CollectAlive(std::vector<Entity> &out) const
+{
+    const std::vector<bool> free = FreeSlots();
+    out.reserve(out.size() + _aliveCount);
+    for (uint32_t index = 0; index < _slots.size(); ++index)
+    {
+        if (!free[index])
+            out.push_back({.index = index, .generation = _slots[index].generation});
+    }
+}
+
+void Registry::Compact(std::vector<Entity> &remap, std::vector<uint32_t> &generations)
+{
+    Flush();
+
+    const std::vector<bool> free = FreeSlots();
+    remap.assign(_slots.size(), NullEntity);
+    generations.resize(_slots.size());
+    for (uint32_t index = 0; index < _slots.size(); ++index)
+        generations[index] = _slots[index].generation;
+
+    /* Slides each live slot down over the free ones; `live` never passes `index`,
+       and slot `live` is written once, so it still holds its own generation here. */
+    uint32_t live = 0;
+    for (uint32_t index = 0; index < _slots.size(); ++index)
+    {
+        if (free[index])
+            continue;
+
+        /* Handles to the destination's earlier occupants must stay stale: a free
+           slot's generation was never handed out, a live one's was. */
+        uint32_t generation = generations[index];
+        if (live != index)
+            generation = std::max(generation, generations[live] + (free[live] ? 0u : 1u));
+
+        remap[index] = {.index = live, .generation = generation};
+        _slots[live] = {generation, NoSlot};
+        _masks[live] = _masks[index];
+        ++live;
+    }
+
+    _slots.resize(live);
+    _slots.shrink_to_fit();
+    _masks.resize(live);
+    _masks.shrink_to_fit();
+    _freeHead.store(NoSlot, std::memory_order_relaxed);
+    _flushedHead = NoSlot;
+    _freshEnd.store(live, std::memory_order_relaxed);
+}
+
 } // namespace Assisi::ECS
\ No newline at end of file
@@ -0,0 +1,317 @@
+/* Copyright (c) 2025 Francisco Vivas Puerto (aka "DaFrancc"). */
+
+#include <Assisi/ECS/Scene.hpp>
+
+#include <Assisi/Core/Reflect/ComponentRegistry.hpp>
+
+#include <algorithm>
+
+namespace Assisi::ECS
+{
+
+std::vector<std::size_t> Scene::EntityRefOffsets(std::type_index type)
+{
+    std::vector<std::size_t> offsets;
+    if (const auto *meta = Core::Reflect::ComponentRegistry::Instance().FindByType(type))
+    {
+        for (const auto &field : meta->fields)
+        {
+            if (field.type == Core::Reflect::FieldType::EntityRef)
+                offsets.push_back(field.offset);
+        }
+    }
+    return offsets;
+}
+
+std::size_t Scene::StorageBytes() const
+{
+    std::size_t bytes = _registry.MemoryBytes() + _archetypes.MemoryBytes();
+    for (const auto &storage : _pools)
+    {
+        if (!storage)
+            continue;
+
+        const PoolStats stats = storage->stats(storage->pool);
+        bytes += stats.denseBytes + stats.sparseBytes;
+    }
+    return bytes;
+}
+
+CompactReport Scene::Compact()
+{
+    CompactReport report{_registry.SlotCount(), 0, StorageBytes(), 0, {}, {}};
+    _registry.Compact(report.remap, report.generations);
+
+    if (_mode == StorageMode::Archetype)
+        _archetypes.Reindex(report.remap, _registry.SlotCount());
+    for (const auto &storage : _pools)
+    {
+        if (storage)
+            storage->reindex(storage->pool, report);
+    }
+    RemapCompactedFields(report);
+
+    report.slotsAfter = _registry.SlotCount();
+    report.bytesAfter = StorageBytes();
+    return report;
+}
+
+void Scene::RemapCompactedFields(const CompactReport &report)
+{
+    const auto remap = [&](Entity e) { return report.Remap(e); };
+
+    /* Sparse-set pools rewrite their own fields in reindex(). */
+    for (const auto &archetype : _archetypes.Archetypes())
+    {
+        for (std::size_t column = 0; column < archetype->Components().size(); ++column)
+        {
+            const std::vector<std::size_t> offsets = EntityRefOffsets(archetype->Components()[column]->type);
+            for (uint32_t row = 0; !offsets.empty() && row < archetype->Size(); ++row)
+                RemapEntityFields(archetype->At(column, row), offsets, remap);
+        }
+    }
+
+    for (const auto &meta : Core::Reflect::ComponentRegistry::Instance().All())
+    {
+        const void *resource = meta.findResource ? meta.findResource(this) : nullptr;
+        if (!resource)
+            continue;
+
+        RemapEntityFields(const_cast<void *>(resource), EntityRefOffsets(meta.typeIndex), remap);
+    }
+}
+
+std::vector<PoolMemoryUsage> Scene::PoolMemory() const
+{
+    std::vector<PoolMemoryUsage> usage;
+    for (const auto &storage : _pools)
+    {
+        if (!storage)
+            continue;
+
+        const PoolStats stats = storage->stats(storage->pool);
+        usage.push_back({stats.id, stats.type, stats.denseBytes + stats.sparseBytes, stats.budget});
+    }
+    return usage;
+}
+
+SceneStats Scene::Stats() const
+{
+    SceneStats stats{_registry.AliveCount(), _registry.SlotCount(), _registry.SlotCount() - _registry.AliveCount(),
+                     {}, {}};
+    for (const auto &storage : _pools)
+    {
+        if (storage)
+            stats.pools.push_back(storage->stats(storage->pool));
+    }
+    for (const auto &archetype : _archetypes.Archetypes())
+    {
+        stats.archetypes.push_back(
+            {archetype->Components().size(), archetype->Size(), archetype->RowCapacity(), archetype->MemoryBytes()});
+    }
+    return stats;
+}
+
+std::expected<void, SnapshotError> Scene::CloneInto(Scene &target) const
+{
+    if (&target == this)
+        return {};
+    if (target._mode != _mode)
+        return std::unexpected(SnapshotError::ModeMismatch);
+
+    for (const ResourceSlot &slot : _resources)
+    {
+        if (slot.value && !slot.copyInto)
+            return std::unexpected(SnapshotError::NotCopyable);
+    }
+    for (const auto &storage : _pools)
+    {
+        if (storage && !storage->copyInto)
+            return std::unexpected(SnapshotError::NotCopyable);
+    }
+
+    /* ArchetypeStorage::CopyFrom() checks every column before it changes anything. */
+    if (_mode == StorageMode::Archetype && !target._archetypes.CopyFrom(_archetypes))
+        return std::unexpected(SnapshotError::NotCopyable);
+
+    /* Forward, never back: systems compare against ticks they saw before. */
+    target._tick = std::max(target._tick, _tick) + 1;
+
+    if (_mode == StorageMode::SparseSet)
+    {
+        for (std::size_t id = 0; id < target._pools.size(); ++id)
+        {
+            PoolStorage *storage = target._pools[id].get();
+            if (storage && !FindStorage(static_cast<ComponentId>(id)))
+                storage->clear(storage->pool);
+        }
+        for (const auto &storage : _pools)
+        {
+            if (storage)
+                storage->copyInto(storage->pool, target);
+        }
+
+        /* Copied pools keep this scene's dense order, which only matches target's
+           groups if this scene has the same ones. */
+        for (auto &group : target._groups)
+        {
+            group->size = 0;
+            PackGroup(*group);
+        }
+    }
+
+    for (std::size_t id = 0; id < target._resources.size(); ++id)
+    {
+        ResourceSlot &slot = target._resources[id];
+        if (slot.value && !FindResource(static_cast<ResourceId>(id)))
+        {
+            slot.destroy(slot.value, target._resource);
+            slot = {};
+        }
+    }
+    for (const ResourceSlot &slot : _resources)
+    {
+        if (slot.value)
+            slot.copyInto(slot.value, target);
+    }
+
+    target._registry.CopyEntities(_registry);
+    return {};
+}
+
+std::expected<std::unique_ptr<Scene>, SnapshotError> Scene::Snapshot() const
+{
+    auto snapshot = std::make_unique<Scene>(_mode);
+    if (auto result = CloneInto(*snapshot); !result)
+        return std::unexpected(result.error());
+    return snapshot;
+}
+
+void Scene::Disconnect(SignalConnection connection)
+{
+    ComponentSignals *signals = FindSignals(connection.component);
+    if (!signals)
+        return;
+
+    auto &listeners = signals->listeners[static_cast<std::size_t>(connection.event)];
+    const auto it = std::ranges::find(listeners, connection.id, &ComponentSignals::Listener::id);
+    if (it == listeners.end())
+        return;
+
+    listeners.erase(it);
+    if (connection.event == ComponentEvent::Removed)
+        --_removalListeners;
+
+    /* Once nobody listens, the component is back to the single bounds check. */
+    if (std::ranges::all_of(signals->listeners, [](const auto &list) { return list.empty(); }))
+        _signals[connection.component].reset();
+}
+
+void Scene::Emit(ComponentSignals &signals, ComponentEvent event, Entity entity)
+{
+    for (const ComponentSignals::Listener &listener : signals.listeners[static_cast<std::size_t>(event)])
+        listener.fn(*this, entity);
+}
+
+void Scene::NotifyDestroy(Entity entity)
+{
+    if (!IsAlive(entity))
+        return;
+
+    const ComponentMask mask = _registry.Mask(entity);
+    for (std::size_t id = 0; id < _signals.size(); ++id)
+    {
+        ComponentSignals *signals = _signals[id].get();
+        if (!signals || signals->listeners[static_cast<std::size_t>(ComponentEvent::Removed)].empty())
+            continue;
+
+        const auto component = static_cast<ComponentId>(id);
+        if (ComponentMask::Fits(component) ? mask.Test(component) : signals->has(*this, entity))
+            Emit(*signals, ComponentEvent::Removed, entity);
+    }
+}
+
+void Scene::NotifyDestroyMany(std::span<const Entity> entities)
+{
+    /* A handle listed twice is still destroyed, and reported, once. */
+    _dying.assign(entities.begin(), entities.end());
+    std::ranges::sort(_dying, [](Entity a, Entity b)
+                      { return a.index != b.index ? a.index < b.index : a.generation < b.generation; });
+    const auto duplicates = std::ranges::unique(_dying);
+    _dying.erase(duplicates.begin(), duplicates.end());
+
+    for (Entity entity : _dying)
+        NotifyDestroy(entity);
+}
+
+void Scene::RemoveFromPool(void *storage, Entity entity)
+{
+    auto &pool = *static_cast<PoolStorage *>(storage);
+    LeaveGroup(pool, entity);
+    pool.remove(pool.pool, entity);
+}
+
+void Scene::EnterGroup(PoolStorage &storage, Entity entity)
+{
+    GroupData *group = storage.group;
+    if (!group)
+        return;
+
+    for (const PoolStorage *pool : group->pools)
+    {
+        if (!pool->has(pool->pool, entity))
+            return;
+    }
+
+    /* Already packed (e.g. Add() overwrote an existing component). */
+    if (storage.indexOf(storage.pool, entity) < group->size)
+        return;
+
+    /* Swap the entity to the first slot past the prefix in every pool, then grow the prefix over it. */
+    for (PoolStorage *pool : group->pools)
+        pool->swapDense(pool->pool, pool->indexOf(pool->pool, entity), group->size);
+    ++group->size;
+}
+
+void Scene::LeaveGroup(PoolStorage &storage, Entity entity)
+{
+    GroupData *group = storage.group;
+    if (!group || !storage.has(storage.pool, entity))
+        return;
+
+    if (storage.indexOf(storage.pool, entity) >= group->size)
+        return;
+
+    /* Shrink the prefix and swap the entity onto the slot it just released. */
+    --group->size;
+    for (PoolStorage *pool : group->pools)
+        pool->swapDense(pool->pool, pool->indexOf(pool->pool, entity), group->size);
+}
+
+Scene::GroupData &Scene::CreateGroup(std::vector<PoolStorage *> pools)
+{
+    GroupData &group = *_groups.emplace_back(std::make_unique<GroupData>(GroupData{std::move(pools), 0}));
+    for (PoolStorage *pool : group.pools)
+        pool->group = &group;
+
+    PackGroup(group);
+    return group;
+}
+
+void Scene::PackGroup(GroupData &group)
+{
+    /* Pack the entities that already qualify, driving from the smallest pool.
+       EnterGroup() only swaps position i with a position <= i, so walking by
+       index never skips an unvisited entity. */
+    PoolStorage *smallest = group.pools.front();
+    for (PoolStorage *pool : group.pools)
+    {
+        if (pool->size(pool->pool) < smallest->size(smallest->pool))
+            smallest = pool;
+    }
+
+    for (std::size_t i = 0; i < smallest->size(smallest->pool); ++i)
+        EnterGroup(*smallest, smallest->entities(smallest->pool)[i]);
+}
+
+} // namespace Assisi::ECS
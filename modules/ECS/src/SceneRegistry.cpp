@@ -3,14 +3,14 @@
 namespace Assisi::ECS
 {
 
-std::expected<Scene *, SceneError> SceneRegistry::Create(std::string_view name)
+std::expected<Scene *, SceneError> SceneRegistry::Create(std::string_view name, StorageMode mode, SceneMemory memory)
 {
     if (Has(name))
     {
         return std::unexpected(SceneError::NameAlreadyTaken);
     }
 
-    auto [iter, inserted] = _scenes.emplace(std::string(name), std::make_unique<Scene>());
+    auto [iter, inserted] = _scenes.emplace(std::string(name), std::make_unique<Scene>(mode, memory));
     return iter->second.get();
 }
 
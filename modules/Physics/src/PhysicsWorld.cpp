@@ -204,22 +204,34 @@ void PhysicsWorld::Update(float deltaTime)
 
 void PhysicsWorld::SyncTransforms(Assisi::ECS::Scene &scene)
 {
-    JPH::BodyInterface &bodies = _impl->physicsSystem.GetBodyInterface();
+    /* The locking BodyInterface is safe to read from several threads, and each
+       entity's TransformComponent (and its change tick) is written by exactly one worker. */
+    const JPH::BodyInterface &bodies = _impl->physicsSystem.GetBodyInterface();
 
-    for (auto [entity, transform, rb] :
-         scene.Query<Assisi::Runtime::TransformComponent, RigidBodyComponent>())
-    {
-        if (!bodies.IsAdded(rb.bodyId) || bodies.GetMotionType(rb.bodyId) == JPH::EMotionType::Static)
+    scene.Query<Assisi::Runtime::TransformComponent, RigidBodyComponent>().ParallelEach(
+        [&bodies, &scene](Assisi::ECS::Entity entity, Assisi::Runtime::TransformComponent &transform,
+                          const RigidBodyComponent &rb)
         {
-            continue;
-        }
-
-        const JPH::RVec3 pos = bodies.GetPosition(rb.bodyId);
-        const JPH::Quat rot = bodies.GetRotation(rb.bodyId);
-
-        transform.position = glm::vec3(pos.GetX(), pos.GetY(), pos.GetZ());
-        transform.rotation = glm::quat(rot.GetW(), rot.GetX(), rot.GetY(), rot.GetZ());
-    }
+            if (!bodies.IsAdded(rb.bodyId) || bodies.GetMotionType(rb.bodyId) == JPH::EMotionType::Static)
+            {
+                return;
+            }
+
+            const JPH::RVec3 pos = bodies.GetPosition(rb.bodyId);
+            const JPH::Quat rot = bodies.GetRotation(rb.bodyId);
+
+            const glm::vec3 position(pos.GetX(), pos.GetY(), pos.GetZ());
+            const glm::quat rotation(rot.GetW(), rot.GetX(), rot.GetY(), rot.GetZ());
+            if (transform.position == position && transform.rotation == rotation)
+            {
+                return;
+            }
+
+            /* Only bodies that actually moved show up in Changed<TransformComponent> queries. */
+            transform.position = position;
+            transform.rotation = rotation;
+            scene.MarkChanged<Assisi::Runtime::TransformComponent>(entity);
+        });
 }
 
 std::pair<glm::vec3, glm::quat> PhysicsWorld::GetBodyTransform(const RigidBodyComponent &body) const
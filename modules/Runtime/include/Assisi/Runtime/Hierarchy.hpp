@@ -8,7 +8,9 @@
 ///
 /// TransformComponent stores local-space TRS. PropagateTransforms() walks the
 /// parent chain and writes the result into TransformComponent::worldMatrix.
-/// For root entities (no parent), worldMatrix == local TRS matrix.
+/// For root entities (no parent), worldMatrix == local TRS matrix.  An
+/// ancestor without a TransformComponent counts as identity: the chain
+/// continues through it to the nearest ancestor that has one.
 
 #include <Assisi/ECS/Entity.hpp>
 #include <Assisi/ECS/Scene.hpp>
@@ -20,8 +22,9 @@ namespace Assisi::Runtime
 
 /// @brief Marks an entity as a child of another entity.
 ///
-/// The parent entity must have a TransformComponent. Entities without this
-/// component are treated as roots (worldMatrix == local TRS matrix).
+/// A parent without a TransformComponent passes its own parent's world
+/// matrix through (see above). Entities without this component are treated
+/// as roots (worldMatrix == local TRS matrix).
 ACOMP()
 struct ParentComponent
 {
@@ -31,8 +34,11 @@ struct ParentComponent
 /// @brief Compute and cache world-space matrices for all entities with a TransformComponent.
 ///
 /// Writes results into TransformComponent::worldMatrix. Must be called once per
-/// frame before DrawScene() or any system that reads worldMatrix. Parent matrices
-/// are memoised so each entity's chain is traversed at most once.
+/// frame before DrawScene() or any system that reads worldMatrix. Root entities
+/// are processed in parallel on Core::JobSystem; children follow serially in
+/// one forward pass ordered by hierarchy depth.  In sparse-set scenes the
+/// ParentComponent pool itself is kept sorted by depth (Scene::SortPool), so
+/// the order only has to be rebuilt when the hierarchy changes.
 void PropagateTransforms(ECS::Scene &scene);
 
 } // namespace Assisi::Runtime
\ No newline at end of file
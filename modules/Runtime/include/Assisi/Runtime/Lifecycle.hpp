@@ -20,7 +20,8 @@ namespace Assisi::Runtime
 
 /// @brief Marker component — entity is destroyed at end of PostUpdate.
 ///
-/// No data.  Presence on an entity is the signal; the value is irrelevant.
+/// No data.  Presence on an entity is the signal; as an empty type its pool
+/// stores no values and queries yield only the entity.
 struct DestroyTag
 {
 };
@@ -31,14 +32,12 @@ struct DestroyTag
 /// Can also be called manually in custom loops or unit tests.
 inline void DestroyMarked(ECS::Scene &scene)
 {
-    std::vector<ECS::Entity> dying;
-    for (auto [e, tag] : scene.Query<DestroyTag>())
-    {
-        (void)tag;
+    /* Reused across frames so steady-state cleanup does not allocate. */
+    thread_local std::vector<ECS::Entity> dying;
+    dying.clear();
+    for (auto [e] : scene.Query<DestroyTag>())
         dying.push_back(e);
-    }
-    for (ECS::Entity e : dying)
-        scene.Destroy(e);
+    scene.DestroyMany(dying);
 }
 
 } // namespace Assisi::Runtime
\ No newline at end of file
@@ -23,6 +23,10 @@ namespace Assisi::Runtime
 /// Zero texture IDs in MeshRendererComponent fall back to engine defaults.
 /// Entities whose MeshRendererComponent::mesh is null are skipped silently.
 ///
+/// The MeshRendererComponent pool is sorted by mesh and then textures, and
+/// bindings already in place are not reissued, so entities sharing a mesh or
+/// material draw back to back with minimal GL state changes.
+///
 /// @param scene       ECS scene to query.
 /// @param view        View matrix (e.g. from Runtime::ViewMatrix).
 /// @param projection  Projection matrix (e.g. from Runtime::ProjectionMatrix).
@@ -18,10 +18,17 @@
 ///         "PointLightComponent": { "color": [1,1,1], "intensity": 100.0, "radius": 20.0 }
 ///       }
 ///     }
-///   ]
+///   ],
+///   "resources": {
+///     "LightingSettings": { "ambient": [0.03,0.03,0.03] }
+///   }
 /// }
 /// @endcode
 ///
+/// "resources" holds the scene's ACOMP(resource) types (see
+/// ECS::Scene::SetResource()) and is omitted when the scene has none.  Load()
+/// keeps resources the file does not mention, since Scene::Clear() does.
+///
 /// Entity IDs are not persisted; loading always clears the scene first and
 /// allocates fresh sequential entities so generation numbers stay at zero.
 ///
@@ -39,6 +46,7 @@
 #include <nlohmann/json.hpp>
 
 #include <Assisi/ECS/Entity.hpp>
+#include <Assisi/ECS/Prefab.hpp>
 #include <Assisi/ECS/Scene.hpp>
 
 namespace Assisi::Runtime
@@ -52,8 +60,8 @@ class SceneSerializer
 
     /// @brief Deserialize entities and components from a JSON value into the scene.
     ///
-    /// Clears the scene before loading.  Only components registered in
-    /// ComponentRegistry are restored; unrecognised names are skipped with a warning.
+    /// Clears the scene before loading.  Only components and resources registered
+    /// in ComponentRegistry are restored; unrecognised names are skipped with a warning.
     static void Load(ECS::Scene &scene, const nlohmann::json &j);
 
     /// @brief Write the scene to a JSON file at the given filesystem path.
@@ -67,6 +75,14 @@ class SceneSerializer
     /// @return true on success, false on any IO or parse error.
     static bool LoadFromFile(ECS::Scene &scene, std::string_view assetPath);
 
+    /// @brief Load a level file fragment as a prefab template, for bulk instancing.
+    ///
+    /// Every entity in the file becomes one entity of each instance; entity
+    /// references between them are remapped per instance (see ECS::Prefab).
+    /// Resources in the file are ignored.
+    /// @return The prefab, or nullopt on any IO or parse error.
+    static std::optional<ECS::Prefab> LoadPrefabFromFile(std::string_view assetPath);
+
     /// @brief Map a live entity to its stable serial index during the current Save.
     ///
     /// Only valid to call from within a component's serialize lambda.
@@ -2,46 +2,110 @@
 
 #include <Assisi/Runtime/Components.hpp>
 
-#include <functional>
-#include <unordered_map>
+#include <algorithm>
+#include <vector>
 
 namespace Assisi::Runtime
 {
 
 void PropagateTransforms(ECS::Scene &scene)
 {
-    std::unordered_map<uint64_t, glm::mat4> cache;
-
-    auto entityKey = [](ECS::Entity e) -> uint64_t
-    {
-        return (static_cast<uint64_t>(e.generation) << 32) | e.index;
-    };
-
     auto localMatrix = [](const TransformComponent &t) -> glm::mat4
     {
         return glm::translate(glm::mat4(1.f), t.position) * glm::mat4_cast(t.rotation) *
                glm::scale(glm::mat4(1.f), t.scale);
     };
 
-    std::function<glm::mat4(ECS::Entity)> worldMatrix = [&](ECS::Entity e) -> glm::mat4
+    /* Pass 1 (parallel): roots have no parent chain, so their world matrix is
+       their local matrix.  Each worker only writes the transforms it visits. */
+    scene.Query<TransformComponent, ECS::Exclude<ParentComponent>>().ParallelEach(
+        [&](ECS::Entity, TransformComponent &transform) { transform.worldMatrix = localMatrix(transform); });
+
+    /* Depth of every child (roots are 0), indexed by entity index.  Each chain
+       is climbed once: the walk stops at the first ancestor already known. */
+    std::vector<uint32_t> depths;
+    std::vector<ECS::Entity> chain;
+    auto computeDepth = [&](ECS::Entity child)
     {
-        const uint64_t key = entityKey(e);
-        if (const auto it = cache.find(key); it != cache.end())
-            return it->second;
+        uint32_t depth = 0;
+        chain.clear();
+        for (ECS::Entity e = child; scene.IsAlive(e);)
+        {
+            if (e.index < depths.size() && depths[e.index] != 0)
+            {
+                depth = depths[e.index];
+                break;
+            }
+            const auto *p = scene.Get<ParentComponent>(e);
+            if (!p)
+                break;
+            chain.push_back(e);
+            e = p->parent;
+        }
+
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        {
+            if (it->index >= depths.size())
+                depths.resize(it->index + 1, 0);
+            depths[it->index] = ++depth;
+        }
+    };
 
-        const auto *t         = scene.Get<TransformComponent>(e);
-        const glm::mat4 local = t ? localMatrix(*t) : glm::mat4(1.f);
+    std::vector<ECS::Entity> children;
+    for (auto [entity, parent] : scene.Query<ParentComponent>())
+    {
+        (void)parent;
+        computeDepth(entity);
+        children.push_back(entity);
+    }
 
-        const auto *p         = scene.Get<ParentComponent>(e);
-        const glm::mat4 world =
-            (p && p->parent != ECS::NullEntity) ? worldMatrix(p->parent) * local : local;
+    const auto byDepth = [&depths](ECS::Entity a, ECS::Entity b) { return depths[a.index] < depths[b.index]; };
 
-        cache.emplace(key, world);
-        return world;
+    /* A child without a transform counts as identity: its children inherit its
+       nearest transformed ancestor's world matrix, kept here by entity index
+       (nullptr = no such ancestor).  Pointers into the pools stay valid, as
+       nothing is added or removed during the pass. */
+    std::vector<const glm::mat4 *> inherited;
+    auto parentWorld = [&](ECS::Entity parent) -> const glm::mat4 *
+    {
+        if (const auto *parentTransform = scene.Get<TransformComponent>(parent))
+            return &parentTransform->worldMatrix;
+        return scene.IsAlive(parent) && parent.index < inherited.size() ? inherited[parent.index] : nullptr;
     };
 
-    for (auto [entity, transform] : scene.Query<TransformComponent>())
-        transform.worldMatrix = worldMatrix(entity);
+    /* Pass 2 (serial): children, shallowest first, so every parent's world
+       matrix is final before any of its children reads it. */
+    auto update = [&](ECS::Entity entity, const ParentComponent &parent)
+    {
+        const glm::mat4 *world = parentWorld(parent.parent);
+        auto *transform = scene.Get<TransformComponent>(entity);
+        if (!transform)
+        {
+            if (entity.index >= inherited.size())
+                inherited.resize(entity.index + 1, nullptr);
+            inherited[entity.index] = world;
+            return;
+        }
+
+        const glm::mat4 local = localMatrix(*transform);
+        transform->worldMatrix = world ? *world * local : local;
+    };
+
+    if (scene.Mode() == ECS::StorageMode::SparseSet)
+    {
+        /* Keep the pool itself in depth order: once the hierarchy settles the
+           sort is a single already-sorted check and the walk is linear. */
+        scene.SortPool<ParentComponent>(byDepth);
+        for (auto [entity, parent] : scene.Query<ParentComponent>())
+            update(entity, parent);
+    }
+    else
+    {
+        /* Archetype storage cannot be reordered; sort the handles instead. */
+        std::ranges::stable_sort(children, byDepth);
+        for (ECS::Entity entity : children)
+            update(entity, *scene.Get<ParentComponent>(entity));
+    }
 }
 
-} // namespace Assisi::Runtime
\ No newline at end of file
+} // namespace Assisi::Runtime
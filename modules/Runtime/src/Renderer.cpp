@@ -6,9 +6,27 @@
 #include <Assisi/Runtime/Components.hpp>
 #include <Assisi/Runtime/Renderer.hpp>
 
+#include <array>
+#include <functional>
+#include <tuple>
+
 namespace Assisi::Runtime
 {
 
+namespace
+{
+
+/* Draw order: by mesh, then by texture set, so consecutive draws share as much GL state as possible. */
+bool DrawsBefore(const MeshRendererComponent &a, const MeshRendererComponent &b)
+{
+    if (a.mesh != b.mesh)
+        return std::less<>{}(a.mesh, b.mesh);
+    return std::tie(a.albedoTextureId, a.normalTextureId, a.metallicTextureId, a.roughnessTextureId) <
+           std::tie(b.albedoTextureId, b.normalTextureId, b.metallicTextureId, b.roughnessTextureId);
+}
+
+} // namespace
+
 void DrawScene(Assisi::ECS::Scene &scene, const glm::mat4 &view, const glm::mat4 &projection,
                Assisi::Render::Shader &shader)
 {
@@ -22,11 +40,15 @@ void DrawScene(Assisi::ECS::Scene &scene, const glm::mat4 &view, const glm::mat4
     shader.SetInt("uMetallic",  2);
     shader.SetInt("uRoughness", 3);
 
-    for (auto [entity, transform, meshRenderer] : scene.Query<TransformComponent, MeshRendererComponent>())
+    /* Skip rebinding what the previous draw already bound; the pool is sorted by DrawsBefore() below. */
+    const Assisi::Render::OpenGL::MeshBuffer *boundMesh = nullptr;
+    std::array<unsigned int, 4> boundTextures{};
+
+    const auto draw = [&](const TransformComponent &transform, const MeshRendererComponent &meshRenderer)
     {
         if (meshRenderer.mesh == nullptr)
         {
-            continue;
+            return;
         }
 
         shader.SetMat4("uModel", transform.worldMatrix);
@@ -51,18 +73,42 @@ void DrawScene(Assisi::ECS::Scene &scene, const glm::mat4 &view, const glm::mat4
                 ? meshRenderer.roughnessTextureId
                 : Assisi::Render::DefaultResources::GreyTextureId();
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, albedoId);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, normalId);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, metallicId);
-        glActiveTexture(GL_TEXTURE3);
-        glBindTexture(GL_TEXTURE_2D, roughnessId);
+        const std::array<unsigned int, 4> textures = {albedoId, normalId, metallicId, roughnessId};
+        for (std::size_t unit = 0; unit < textures.size(); ++unit)
+        {
+            if (boundTextures[unit] == textures[unit])
+            {
+                continue;
+            }
+            glActiveTexture(GL_TEXTURE0 + static_cast<unsigned int>(unit));
+            glBindTexture(GL_TEXTURE_2D, textures[unit]);
+            boundTextures[unit] = textures[unit];
+        }
 
-        meshRenderer.mesh->Bind();
+        if (boundMesh != meshRenderer.mesh)
+        {
+            meshRenderer.mesh->Bind();
+            boundMesh = meshRenderer.mesh;
+        }
         glDrawElements(GL_TRIANGLES, static_cast<int>(meshRenderer.mesh->IndexCount()), GL_UNSIGNED_INT, nullptr);
+    };
+
+    /* The owning group keeps both pools packed, so the common case is a linear walk.
+       Fall back to a plain query in archetype scenes or if another group owns one of the pools.
+       The group exists before sorting so the sort keeps both pools aligned; once the
+       order holds, sorting is a single linear check. */
+    (void)scene.Group<TransformComponent, MeshRendererComponent>();
+    scene.SortPool<MeshRendererComponent>(&DrawsBefore);
+
+    if (auto group = scene.Group<TransformComponent, MeshRendererComponent>())
+    {
+        group->Each([&draw](Assisi::ECS::Entity, const TransformComponent &transform,
+                            const MeshRendererComponent &meshRenderer) { draw(transform, meshRenderer); });
+        return;
     }
+
+    for (auto [entity, transform, meshRenderer] : scene.Query<TransformComponent, MeshRendererComponent>())
+        draw(transform, meshRenderer);
 }
 
 } // namespace Assisi::Runtime
\ No newline at end of file
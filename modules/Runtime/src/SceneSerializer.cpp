@@ -107,6 +107,17 @@ nlohmann::json SceneSerializer::Save(ECS::Scene &scene)
         });
     }
 
+    // Resources, while the context is still live for their entity references.
+    nlohmann::json resources = nlohmann::json::object();
+    for (const auto &meta : registry.All())
+    {
+        if (!meta.findResource)
+            continue;
+
+        if (const void *resource = meta.findResource(&scene))
+            resources[meta.name] = meta.serialize(resource);
+    }
+
     s_context.reset();
 
     nlohmann::json result;
@@ -116,6 +127,9 @@ nlohmann::json SceneSerializer::Save(ECS::Scene &scene)
     for (auto &[key, entityJson] : entityMap)
         result["entities"].push_back(std::move(entityJson));
 
+    if (!resources.empty())
+        result["resources"] = std::move(resources);
+
     return result;
 }
 
@@ -149,7 +163,7 @@ void SceneSerializer::Load(ECS::Scene &scene, const nlohmann::json &j)
         for (const auto &[compName, compData] : entityJson.at("components").items())
         {
             const auto *meta = registry.Find(compName);
-            if (!meta)
+            if (!meta || !meta->addToScene)
             {
                 Core::Log::Warn("SceneSerializer: unknown component '{}' - skipped", compName);
                 continue;
@@ -158,6 +172,21 @@ void SceneSerializer::Load(ECS::Scene &scene, const nlohmann::json &j)
         }
     }
 
+    // Resources last, so their entity references resolve.
+    if (j.contains("resources"))
+    {
+        for (const auto &[resName, resData] : j.at("resources").items())
+        {
+            const auto *meta = registry.Find(resName);
+            if (!meta || !meta->setResource)
+            {
+                Core::Log::Warn("SceneSerializer: unknown resource '{}' - skipped", resName);
+                continue;
+            }
+            meta->setResource(&scene, resData);
+        }
+    }
+
     s_context.reset();
 }
 
@@ -198,4 +227,12 @@ bool SceneSerializer::LoadFromFile(ECS::Scene &scene, std::string_view assetPath
     }
 }
 
+std::optional<ECS::Prefab> SceneSerializer::LoadPrefabFromFile(std::string_view assetPath)
+{
+    ECS::Prefab prefab;
+    if (!LoadFromFile(prefab.Template(), assetPath))
+        return std::nullopt;
+    return prefab;
+}
+
 } // namespace Assisi::Runtime
\ No newline at end of file
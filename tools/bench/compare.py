@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""compare.py — Assisi benchmark report comparison
+
+Matches the results of two JSON reports written by an Assisi-Bench-* target
+(by case name and params) and prints the change in median ns/op.  Exits with
+status 1 if any case got slower than the threshold, so CI can gate on it.
+
+Usage:
+    python compare.py <baseline.json> <current.json> [--threshold 10]
+
+    --threshold <pct>  Slowdown, in percent, that counts as a regression.
+"""
+
+import sys
+import json
+import argparse
+from pathlib import Path
+
+
+def _key(result: dict) -> str:
+    return result['name'] + ' ' + json.dumps(result.get('params', {}), sort_keys=True)
+
+
+def load(path: Path) -> dict:
+    report = json.loads(path.read_text(encoding='utf-8'))
+    return {_key(r): r for r in report.get('results', [])}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Assisi benchmark report comparison')
+    parser.add_argument('baseline', type=Path, help='Report of the reference build')
+    parser.add_argument('current', type=Path, help='Report of the build under test')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='Slowdown in percent that counts as a regression (default: 10)')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    for key, result in current.items():
+        before = baseline.get(key)
+        if before is None:
+            print(f'  new   {key}: {result["nsPerOpMedian"]:.2f} ns/op')
+            continue
+
+        old, new = before['nsPerOpMedian'], result['nsPerOpMedian']
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        slower = change > args.threshold
+        regressions += slower
+        tag = 'SLOW ' if slower else '     '
+        print(f'{tag} {key}: {old:.2f} -> {new:.2f} ns/op ({change:+.1f}%)')
+
+    for key in baseline.keys() - current.keys():
+        print(f'  gone  {key}')
+
+    print(f'compare: {regressions} regression(s) over {args.threshold:g}%')
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == '__main__':
+    main()
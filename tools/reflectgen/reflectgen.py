@@ -3,6 +3,7 @@
 
 Scans C++ headers for ACOMP/AFIELD annotations and emits .generated.cpp files
 that register each component with Assisi::Core::Reflect::ComponentRegistry.
+Structs marked ACOMP(resource) are registered as scene resources instead.
 
 Usage:
     python reflectgen.py <header> [<header> ...] --outdir <dir> [--include <path>]
@@ -366,15 +367,14 @@ def _gen_serialize(fields: list[FieldInfo]) -> str:
     return '\n'.join(lines)
 
 
-def _gen_deserialize(fields: list[FieldInfo]) -> str:
+def _gen_deserialize(fields: list[FieldInfo], resource: bool = False) -> str:
     serializable = [f for f in fields if not f.args.has('transient') and TYPES.get(f.cpp_type)]
     unsupported  = [f for f in fields if not f.args.has('transient') and not TYPES.get(f.cpp_type)]
 
-    lines = [
-        'auto& scene = *static_cast<Assisi::ECS::Scene*>(scene_ptr);',
-        'Assisi::ECS::Entity e{entity_index, entity_gen};',
-        'T comp{};',
-    ]
+    lines = ['auto& scene = *static_cast<Assisi::ECS::Scene*>(scene_ptr);']
+    if not resource:
+        lines.append('Assisi::ECS::Entity e{entity_index, entity_gen};')
+    lines.append('T comp{};')
 
     if not serializable and not unsupported:
         lines.append('(void)j;')
@@ -384,10 +384,85 @@ def _gen_deserialize(fields: list[FieldInfo]) -> str:
         for f in serializable:
             lines.append(TYPES[f.cpp_type].deserialize.format(f=f.name, a=f'comp.{f.name}'))
 
-    lines.append('(void)scene.Add(e, comp);')
+    if resource:
+        lines.append('scene.SetResource<T>(std::move(comp));')
+    else:
+        lines.append('(void)scene.Add(e, comp);')
     return '\n'.join(lines)
 
 
+def _gen_each(args: AnnotArgs) -> str:
+    lines = ['auto& scene = *static_cast<Assisi::ECS::Scene*>(scene_ptr);']
+    if args.has('soa'):
+        # SoA pools hand out SoaRef<T>; gather a temporary T for the callback.
+        lines += [
+            'for (auto [e, comp] : scene.Query<T>())',
+            '{',
+            '    const T value = comp.Load();',
+            '    cb(e.index, e.generation, &value);',
+            '}',
+        ]
+    else:
+        # Tags (empty types) add nothing to a query row; hand out a default instance for them.
+        lines += [
+            'for (auto&& row : scene.Query<T>())',
+            '{',
+            '    std::apply([&](Assisi::ECS::Entity e, const auto&... comp)',
+            '    {',
+            '        if constexpr (sizeof...(comp) == 0)',
+            '        {',
+            '            const T tag{};',
+            '            cb(e.index, e.generation, &tag);',
+            '        }',
+            '        else',
+            '        {',
+            '            cb(e.index, e.generation, &comp...);',
+            '        }',
+            '    }, row);',
+            '}',
+        ]
+    return '\n'.join(lines)
+
+
+def _gen_find_resource() -> str:
+    return '\n'.join([
+        'auto& scene = *static_cast<Assisi::ECS::Scene*>(scene_ptr);',
+        'return scene.Resource<T>();',
+    ])
+
+
+def _gen_scene_callbacks(comp: ComponentInfo) -> str:
+    """The addToScene/iterateEntities/findResource/setResource initializers, in ComponentMeta order."""
+    if comp.args.has('resource'):
+        find        = _indent(_gen_find_resource(), 12)
+        deserialize = _indent(_gen_deserialize(comp.fields, resource=True), 12)
+        return f"""\
+        nullptr,
+        nullptr,
+        [](void* scene_ptr) -> const void*
+        {{
+{find}
+        }},
+        [](void* scene_ptr, const nlohmann::json& j)
+        {{
+{deserialize}
+        }}"""
+
+    deserialize = _indent(_gen_deserialize(comp.fields), 12)
+    each        = _indent(_gen_each(comp.args), 12)
+    return f"""\
+        [](void* scene_ptr, uint32_t entity_index, uint32_t entity_gen, const nlohmann::json& j)
+        {{
+{deserialize}
+        }},
+        [](void* scene_ptr, std::function<void(uint32_t, uint32_t, const void*)> cb)
+        {{
+{each}
+        }},
+        nullptr,
+        nullptr"""
+
+
 def generate_cpp(components: list[ComponentInfo], include_path: str) -> str:
     entity_ref_types = {'ECS::Entity', 'Assisi::ECS::Entity'}
     has_entity_refs  = any(
@@ -418,7 +493,7 @@ namespace
         var_name    = f'_reflectgen_{comp.name}'
         field_metas = ',\n            '.join(_gen_field_meta(f) for f in comp.fields)
         serialize   = _indent(_gen_serialize(comp.fields), 12)
-        deserialize = _indent(_gen_deserialize(comp.fields), 12)
+        callbacks   = _gen_scene_callbacks(comp)
 
         blocks.append(f"""\
 // ── {comp.name} {'─' * max(0, 74 - len(comp.name))}
@@ -435,16 +510,7 @@ static const bool {var_name} = []() -> bool
         {{
 {serialize}
         }},
-        [](void* scene_ptr, uint32_t entity_index, uint32_t entity_gen, const nlohmann::json& j)
-        {{
-{deserialize}
-        }},
-        [](void* scene_ptr, std::function<void(uint32_t, uint32_t, const void*)> cb)
-        {{
-            auto& scene = *static_cast<Assisi::ECS::Scene*>(scene_ptr);
-            for (auto [e, comp] : scene.Query<T>())
-                cb(e.index, e.generation, &comp);
-        }}
+{callbacks}
     }});
     return true;
 }}();